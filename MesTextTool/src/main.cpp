@@ -9,6 +9,7 @@ console::helper_t console::helper{ L"" PROJECT_NAME " v" PROJECT_VERSION };
 namespace mes_text_tool 
 {
 	static xstr::buffer<wchar_t> logs{};
+	inline static constexpr size_t default_memory_budget{ size_t{ 256 } << 20 };
 	inline static constexpr std::wstring_view information
 	{
 		L"----------------------------------------------------\n"
@@ -55,7 +56,7 @@ namespace mes_text_tool
 		}
 	}
 
-	static auto get_value_from_argv(const int argc, const wchar_t* const argv[], bool& log, mes::unioninfo& info, uint32_t& cdpg)
+	static auto get_value_from_argv(const int argc, const wchar_t* const argv[], bool& log, mes::unioninfo& info, uint32_t& cdpg, std::wstring& cache, bool& binary, bool& project, size_t& budget)
 	{
 		for (size_t i = 1; i < argc - 1; i++)
 		{
@@ -93,6 +94,34 @@ namespace mes_text_tool
 			{
 				log = true;
 			}
+			else if (arg == L"mtb")
+			{
+				binary = true; // 导出为 .mtb 二进制容器
+			}
+			else if (arg == L"project")
+			{
+				project = true; // 所有脚本共用一个去重后的 project.txt
+			}
+			else if (arg == L"cache" || arg.starts_with(L"cache="))
+			{
+				// -cache 使用程序所在目录下的 cache 文件夹，-cache=<dir> 使用指定的目录
+				cache = arg.size() > 6 ? 
+					std::wstring{ arg.substr(6) } : 
+					xfsys::path::join(xfsys::path::parent(argv[0]), L"cache");
+			}
+			else if (arg == L"stream" || arg.starts_with(L"stream="))
+			{
+				// -stream 按窗口流式导出，-stream=<MiB> 指定所有线程共用的内存预算
+				budget = default_memory_budget;
+				if (arg.size() > 7)
+				{
+					const auto value{ xstr::to_integer<size_t>(arg.substr(7)) };
+					if (value.has_value() && value.value() != 0)
+					{
+						budget = value.value() << 20;
+					}
+				}
+			}
 			else if (arg.starts_with(L"advtxt"))
 			{
 				const auto advtxt_info{ mes::advtxt::advtxt_info::parse(xstr::cvt::to_utf8(arg)) };
@@ -165,7 +194,7 @@ namespace mes_text_tool
 			{
 				"[ILLEGAL PARAMETER] \n"
 				"At least 1 or 2 valid parameters are required.\n"
-				"Args: [-LOG <option>] [-CP <option>] [-GAME <option>] [PATH <must>]\n"
+				"Args: [-LOG <option>] [-CP <option>] [-GAME <option>] [-CACHE[=<dir>] <option>] [-MTB <option>] [-PROJECT <option>] [-STREAM[=<MiB>] <option>] [PATH <must>]\n"
 				"Example: MesTextTool.exe -log -cp932 -dc3wy "
 				"D:\\YourGames\\DC3WY\\Advdata\\MES\n"
 			};
@@ -176,11 +205,15 @@ namespace mes_text_tool
 		else 
 		{
 			bool enable_console_log{ false };
+			bool enable_binary_dump{ false };
+			bool enable_project_mode{ false };
+			size_t memory_budget{};
+			std::wstring cache_directory{};
 			mes::unioninfo input_script_info{};
 			uint32_t input_code_page{ mes::scripts::defualt_code_page };
 
 			get_value_from_exename(argv[0], enable_console_log, input_script_info, input_code_page);
-			get_value_from_argv(argc, argv, enable_console_log, input_script_info, input_code_page);
+			get_value_from_argv(argc, argv, enable_console_log, input_script_info, input_code_page, cache_directory, enable_binary_dump, enable_project_mode, memory_budget);
 
 			const std::wstring_view  input_path{ argv[argc - 1] };
 			const std::wstring_view output_path{ xfsys::path::parent(argv[0]) };
@@ -189,6 +222,10 @@ namespace mes_text_tool
 
 			handler.set_script_info(input_script_info);
 			handler.set_mes_code_page(input_code_page);
+			handler.set_cache_directory(cache_directory);
+			handler.set_binary_dump(enable_binary_dump);
+			handler.set_project_mode(enable_project_mode);
+			handler.set_memory_budget(memory_budget);
 
 			if (!enable_console_log)
 			{
@@ -206,27 +243,25 @@ namespace mes_text_tool
 						return;
 					}
 
+					// 日志先累积在批量输出中，颜色随文本一起记录，不再每行切换一次控制台属性
 					switch (level)
 					{
 					case mes::scripts::handler::message_level::normal:
 					{
-						xcout::helper.writeline(message);
+						xcout::helper.batch().writeline(message);
 						break;
 					}
 					case mes::scripts::handler::message_level::warning:
 					{
-						xcout::helper.set_attrs(xcout::attrs::text_yellow);
-						xcout::helper.writeline(message);
+						xcout::helper.batch().writeline(message, xcout::attrs::text_yellow);
 						break;
 					}
 					case mes::scripts::handler::message_level::error:
 					{
-						xcout::helper.set_attrs(xcout::attrs::text_dark_red);
-						xcout::helper.writeline(message);
+						xcout::helper.batch().writeline(message, xcout::attrs::text_dark_red);
 						break;
 					}
 					};
-					xcout::helper.reset_attrs();
 				}
 			);
 
@@ -237,7 +272,7 @@ namespace mes_text_tool
 			}
 
 			mes_text_tool::logs.write(information);
-			mes_text_tool::logs.write_as_format(L"- Time: %llfs\n", time);
+			mes_text_tool::logs.format(L"- Time: {:f}s\n", time);
 			const xfsys::file file{ xfsys::create(output_path, L"output.log") };
 			file.write(mes_text_tool::logs.u8string(), xfsys::file::pos::begin);
 			mes_text_tool::logs.clear();
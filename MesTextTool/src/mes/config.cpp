@@ -157,17 +157,17 @@ namespace mes
 		{
 			input_path.assign("D:\\YourGames\\Name\\Advdata\\MES");
 		}
-		buffer.write_as_format("%s\n%s\n\n", config::k_path, input_path.data());
-		buffer.write_as_format("%s\n%d\n\n", config::k_cdpg, config.use_code_page);
-		buffer.write_as_format("%s\n%d\n\n", config::k_tmin, config.text_min_length);
-		buffer.write_as_format("%s\n%d\n\n", config::k_tmax, config.text_max_length);
+		buffer.format("{}\n{}\n\n", config::k_path, input_path);
+		buffer.format("{}\n{}\n\n", config::k_cdpg, config.use_code_page);
+		buffer.format("{}\n{}\n\n", config::k_tmin, config.text_min_length);
+		buffer.format("{}\n{}\n\n", config::k_tmax, config.text_max_length);
 
 		buffer.write(reinterpret_cast<const char8_t*>(config::k_bfrp)).write('\n');
 		if (!config.before_replaces.empty())
 		{
 			for (const auto& [key, value] : config.before_replaces)
 			{
-				buffer.write_as_format("[%s]:[%s]\n", key.data(), value.data());
+				buffer.format("[{}]:[{}]\n", xstr::convert_to_utf8(key), xstr::convert_to_utf8(value));
 			}
 			buffer.write(u8"\n\n");
 		}
@@ -181,7 +181,7 @@ namespace mes
 		{
 			for (const auto& [key, value] : config.after_replaces)
 			{
-				buffer.write_as_format("[%s]:[%s]\n", key.data(), value.data());
+				buffer.format("[{}]:[{}]\n", xstr::convert_to_utf8(key), xstr::convert_to_utf8(value));
 			}
 			buffer.write(u8"\n\n");
 		}
@@ -1,10 +1,17 @@
 #pragma once
+#include <map>
+#include <mutex>
 #include <span>
+#include <array>
+#include <bitset>
 #include <variant>
 #include <vector>
+#include <memory_resource>
 #include <xmem.hpp>
 #include <xfsys.hpp>
 #include <mes_advtxt.hpp>
+#include <mes_cipher.hpp>
+#include <mes_cache.hpp>
 
 namespace mes 
 {
@@ -14,6 +21,8 @@ namespace mes
 	namespace text 
 	{
 		class entry;
+		class entries;
+		class dump_writer;
 	}
 
 	struct token
@@ -82,6 +91,12 @@ namespace mes
 			auto is(const uint8_t key) const noexcept -> bool;
 		};
 
+		// 操作码对应的指令类型，判定顺序与 section 的先后一致：uint8x2 > uint8str > string/encstr > uint16x4
+		enum class opcode_kind : uint8_t
+		{
+			unknown, uint8x2, uint8str, string, encstr, uint16x4
+		};
+
 		enum offset_t : uint8_t
 		{
 			offset1, // head[0] * 0x04 + 0x04
@@ -98,12 +113,26 @@ namespace mes
 		section uint16x4; // [op: byte] [arg1: uint16] [arg2: uint16] [arg3: uint16] [arg4: uint16]
 		uint8_t   enckey;
 		std::vector<uint8_t> opstrs; // the opcode for unencrypted strings in scene text
+		std::bitset<0x100>   opstrs_set{}; // membership set of opstrs, kept in sync by parse/set/operator=
+		std::array<opcode_kind, 0x100> opcode_kinds{}; // per-opcode dispatch table built from the sections
+
+		inline auto is_opstrs(const uint8_t opcode) const noexcept -> bool;
+		inline auto kind(const uint8_t opcode) const noexcept -> opcode_kind;
+		inline auto is_text(const uint8_t opcode) const noexcept -> bool; // encstr or opstrs: exported as text
+
+		auto decrypt(const std::span<const uint8_t> input, uint8_t* output) const noexcept -> void;
+		auto encrypt(const std::span<const uint8_t> input, uint8_t* output) const noexcept -> void;
 
 		static auto infos() noexcept -> const std::vector<script_info>&;
 		static auto parse(std::string_view data) noexcept -> const script_info*;
 		static auto query(const uint16_t version)       noexcept -> const script_info*;
 		static auto query(const std::span<uint8_t> data)noexcept -> const script_info*;
 		static auto query(const std::string_view name)  noexcept -> const script_info*;
+
+		// 版本号相同的候选可能不止一个，detect 会用每个候选试解析并按得分挑选
+		static auto candidates(const std::span<uint8_t> data) noexcept -> std::vector<const script_info*>;
+		static auto detect(const std::span<uint8_t> data) noexcept -> const script_info*;
+		static auto detect(const std::span<uint8_t> data, const std::span<const script_info* const> candidates) noexcept -> const script_info*;
 		
 		auto operator=(const mes::script_info&) noexcept -> script_info&;
 
@@ -152,26 +181,45 @@ namespace mes
 			}
 		};
 
+		inline static constexpr size_t probe_size{ 0x4000 }; // 自动识别时试解析的 asmbin 前缀长度
+		inline static constexpr size_t parallel_threshold{ 0x400000 }; // asmbin 达到该大小时按 label 分块并行解析
+		inline static constexpr size_t parallel_chunk    { 0x100000 }; // 并行解析时每块的最小长度
+
 		script_view() = default;
 
-		script_view(const std::span<uint8_t> raw, const script_info* const script_info = nullptr);
-		script_view(const std::span<uint8_t> raw, const std::string_view script_info_name);
-		script_view(const std::span<uint8_t> raw, const uint16_t script_info_version);
+		// resource 用于 token 表等随脚本大小增长的容器，调用者需保证其生命周期长于 script_view；
+		// script_info 为空时不解析，需要自动识别时使用 script_view::detect
+		script_view(const std::span<uint8_t> raw, const script_info* const script_info, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		script_view(const std::span<uint8_t> raw, const std::string_view script_info_name, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		script_view(const std::span<uint8_t> raw, const uint16_t script_info_version, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		script_view(const std::span<uint8_t> raw, const script_info* const script_info, const token_cache::entry& cached, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		// 按候选逐个试解析并打分，识别出 script_info 后再解析整个脚本
+		static auto detect(const std::span<uint8_t> raw, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> script_view;
 
 		auto raw () const noexcept -> const view_t<uint8_t>&;
 		auto info() const noexcept -> const script_info* const;
 
 		auto asmbin () const noexcept -> const view_t<uint8_t>&;
 		auto labels () const noexcept -> const view_t<int32_t>&;
-		auto tokens () const noexcept -> const std::vector<token>&;
+		auto tokens () const noexcept -> const std::pmr::vector<token>&;
+		auto texts  () const noexcept -> const std::pmr::vector<uint32_t>&; // 文本条目所在的 token 下标，只有从缓存载入时才有
 		auto version() const noexcept -> uint16_t;
 
+		static auto score(const std::span<uint8_t> raw, const script_info* const info, const size_t limit = probe_size) noexcept -> int64_t;
+
 	protected:
 		
 		mutable uint16_t m_version{};
 		mutable const script_info* m_info{};
 
-		mutable std::vector<token> m_tokens{};
+		mutable std::pmr::vector<token> m_tokens{};
+		mutable std::pmr::vector<uint32_t> m_texts{};
 		mutable view_t<int32_t>    m_labels{};
 		mutable view_t<uint8_t>    m_asmbin{};
 		mutable view_t<uint8_t>    m_raw{};
@@ -179,6 +227,63 @@ namespace mes
 		auto init_by_offset1() noexcept -> void;
 		auto init_by_offset2() noexcept -> void;
 		auto token_parse() noexcept -> void;
+		template<class kind_t>
+		auto token_parse(const kind_t& kind) noexcept -> void;
+		template<class kind_t>
+		auto token_parse_parallel(const kind_t& kind) noexcept -> bool;
+		auto token_adopt(const token_cache::entry& cached) noexcept -> bool;
+		auto init_layout() noexcept -> bool;
+
+		friend class script_stream;
+	};
+
+	// 按窗口流式读取脚本：文件分块读入同一块缓冲区，逐条产生 token 而不建立 token 表，内存只与窗口大小有关
+	// 跨越窗口末尾的 token 连同之后的内容移到缓冲区开头后继续读入，单条 token 比整个窗口还长时缓冲区加倍
+	class script_stream
+	{
+	public:
+
+		inline static constexpr size_t default_window{ 0x40000 };
+
+		// 读入第一个窗口，至少包含文件头、label 表以及识别脚本类型用的 asmbin 前缀（advtxt 只读第一个窗口）；
+		// lease 中应已包含 window，超出的部分追加到其中
+		script_stream(const xfsys::file& file, const size_t window = default_window, xmem::budget_lease* lease = nullptr) noexcept;
+
+		script_stream(const script_stream&) = delete;
+		auto operator=(const script_stream&) -> script_stream& = delete;
+
+		// 第一个窗口的内容，只在 begin 之前有效
+		inline auto prefix() noexcept -> std::span<uint8_t>;
+
+		// 按 info 确定 asmbin 的位置，之后才能调用 next
+		auto begin(const script_info* const info) noexcept -> bool;
+
+		// token 的 data 只在下一次调用 next 之前有效；到达末尾或遇到无法识别的操作码时返回 false
+		auto next(mes::token& token) noexcept -> bool;
+
+		// 释放缓冲区并从 lease 中归还相应的预算，之后不能再使用该 stream
+		auto release() noexcept -> void;
+
+		inline auto info() const noexcept -> const script_info*;
+		inline auto asmbin_offset() const noexcept -> int32_t;
+		inline auto completed() const noexcept -> bool; // 是否没有出错地解析到了文件末尾
+
+	protected:
+
+		auto fill() noexcept -> bool;
+		auto grow(const size_t size) noexcept -> void;
+
+		const xfsys::file& m_file;
+		xmem::budget_lease* m_lease{};
+		const script_info* m_info{};
+
+		xmem::buffer<uint8_t> m_buffer{};
+		size_t m_file_size{};
+		size_t m_base {}; // 缓冲区开头在文件中的位置
+		size_t m_count{}; // 缓冲区中已读入的字节数
+		size_t m_pos  {}; // 下一条 token 在缓冲区中的位置
+		int32_t m_asmbin{};
+		bool m_failed{}, m_finished{};
 	};
 
 	class unioninfo
@@ -239,12 +344,37 @@ namespace mes
 		view_type m_type{};
 	};
 
+	// 同一目录下的脚本通常来自同一个游戏：前几个文件的识别结果一致后就记下来，后续文件直接使用。
+	// 由调用者持有并交给处理各个文件的 script_helper 共用，多个线程可以同时调用 detect
+	class script_detector
+	{
+	public:
+
+		inline static constexpr uint32_t samples{ 3 };
+
+		auto detect(const std::wstring_view directory, const std::span<uint8_t> data) noexcept -> const script_info*;
+
+	protected:
+
+		struct detection
+		{
+			const script_info* info{};
+			std::vector<std::pair<const script_info*, uint32_t>> votes{};
+		};
+
+		std::mutex m_mutex{};
+		std::map<std::pair<std::wstring, const script_info*>, detection> m_detected{};
+	};
+
 	class script_helper
 	{
 	public:
 
 		inline script_helper () noexcept {};
-		inline ~script_helper() noexcept {};
+		inline ~script_helper() noexcept 
+		{
+			this->release_buffer(std::move(this->m_buffer));
+		};
 
 		script_helper(const unioninfo            using_script_info) noexcept;
 		script_helper(const std::string_view   using_script_info_name) noexcept;
@@ -253,6 +383,10 @@ namespace mes
 		auto data_view() const noexcept -> const unionmes_view&;
 		auto view_info() const noexcept -> const unioninfo&;
 		auto using_script_info(const unioninfo info) noexcept -> script_helper&;
+		auto use_cache(const std::wstring_view directory) noexcept -> script_helper&; // 空路径表示不使用缓存
+		auto use_resource(std::pmr::memory_resource* resource) noexcept -> script_helper&; // 之后载入的脚本视图从 resource 分配
+		auto use_detector(script_detector* detector) noexcept -> script_helper&; // 为空时每个文件单独识别
+		auto use_pool(const bool enable) noexcept -> script_helper&; // 关闭后脚本缓冲区不经过共享的 buffer_pool，随 script_helper 释放
 
 		auto load(const xfsys::file& file) noexcept -> script_helper&;
 		auto load(const std::wstring_view  path, const bool check = true) noexcept -> script_helper&;
@@ -269,21 +403,48 @@ namespace mes
 		auto save(const std::u8string_view directory, const std::u8string_view name) noexcept -> bool;
 
 		auto export_text(const bool absolute_file_offset = true) const noexcept -> std::vector<text::entry>;
+		auto export_text(text::entries& output, const bool absolute_file_offset = true) const noexcept -> bool;
 		auto import_text(const std::vector<text::entry>& texts, uint32_t use_code_page = 932, bool absolute_file_offset = true) noexcept -> bool;
+		auto import_text(const text::entries& texts, uint32_t texts_code_page, uint32_t use_code_page = 932, bool absolute_file_offset = true) noexcept -> bool;
+
+		// 流式导出：stream_begin 识别脚本类型并定位 asmbin，之后 stream_export 把文本逐条写入 writer，
+		// 不建立 token 表与条目表，编号与偏移和 export_text 导出的结果一致；advtxt 不支持流式读取
+		auto stream_begin(script_stream& stream, const std::wstring_view directory = {}) noexcept -> bool;
+		static auto stream_export(script_stream& stream, text::dump_writer& writer, const bool absolute_file_offset = true) noexcept -> bool;
 
 		auto last_info_name() const noexcept -> std::string_view;
+		auto unmatched_labels() const noexcept -> const std::vector<size_t>&;
 
 	protected:
 
-		auto advtxt_import(const std::vector<text::entry>& texts, uint32_t use_code_page, bool absolute_file_offset) noexcept -> bool;
-		auto script_import(const std::vector<text::entry>& texts, uint32_t use_code_page, bool absolute_file_offset) noexcept -> bool;
+		// lookup(offset, converted) 返回该偏移处已转换为目标代码页的译文，空串表示保留原文
+		template<class lookup_t>
+		auto advtxt_import(lookup_t&& lookup, bool absolute_file_offset) noexcept -> bool;
+		template<class lookup_t>
+		auto script_import(lookup_t&& lookup, bool absolute_file_offset) noexcept -> bool;
+
+		inline static constexpr size_t no_token{ static_cast<size_t>(-1) };
+		static auto label_tokens(const mes::script_view& view, std::vector<size_t>& unmatched) noexcept -> std::vector<size_t>;
+
+		auto script_export(text::entries& texts, bool absolute_file_offset) const noexcept -> bool;
+		static auto entry_text(const text::entry& entry, uint32_t use_code_page, std::string& converted) noexcept -> std::string_view;
+		auto advtxt_export(text::entries& texts, bool absolute_file_offset) const noexcept -> bool;
+
+		auto detect(const std::span<uint8_t> data) noexcept -> const script_info*;
 
-		auto script_export(std::vector<text::entry>& texts, bool absolute_file_offset) const noexcept -> bool;
-		auto advtxt_export(std::vector<text::entry>& texts, bool absolute_file_offset) const noexcept -> bool;
+		inline auto acquire_buffer(const size_t size) -> xmem::buffer<uint8_t>;
+		inline auto release_buffer(xmem::buffer<uint8_t>&& buffer) noexcept -> void;
 
+		mutable std::wstring m_directory{};
+		script_detector* m_detector{};
+
+		token_cache m_cache{};
+		mutable std::vector<size_t> m_unmatched_labels{}; // 上一次 script_import 中没有对应 token 的 label 下标
 		mutable unioninfo m_view_info{};
 		mutable unionmes_view m_data_view{};
 		mutable xmem::buffer<uint8_t> m_buffer{};
+		std::pmr::memory_resource* m_resource{ std::pmr::get_default_resource() };
+		bool m_pooled{ true };
 	};
 
 	inline auto token::uint16x4() const noexcept -> const token::uint16x4_t*
@@ -321,13 +482,38 @@ namespace mes
 		return !(beg == end && beg == 0xFF) && (key >= beg && key <= end);
 	}
 
-	inline script_view::script_view(const std::span<uint8_t> raw, const uint16_t version)
-		: script_view{ raw, script_info::query(version) }
+	inline auto script_info::is_opstrs(const uint8_t opcode) const noexcept -> bool
+	{
+		return this->opstrs_set.test(opcode);
+	}
+
+	inline auto script_info::kind(const uint8_t opcode) const noexcept -> opcode_kind
+	{
+		return this->opcode_kinds[opcode];
+	}
+
+	inline auto script_info::is_text(const uint8_t opcode) const noexcept -> bool
+	{
+		return this->encstr.is(opcode) || (opcode != 0x00 && this->is_opstrs(opcode));
+	}
+
+	inline auto script_info::decrypt(const std::span<const uint8_t> input, uint8_t* output) const noexcept -> void
+	{
+		mes::cipher::add(input.data(), output, input.size(), this->enckey);
+	}
+
+	inline auto script_info::encrypt(const std::span<const uint8_t> input, uint8_t* output) const noexcept -> void
+	{
+		mes::cipher::sub(input.data(), output, input.size(), this->enckey);
+	}
+
+	inline script_view::script_view(const std::span<uint8_t> raw, const uint16_t version, std::pmr::memory_resource* resource)
+		: script_view{ raw, script_info::query(version), resource }
 	{
 	}
 
-	inline script_view::script_view(const std::span<uint8_t> raw, const std::string_view name)
-		:script_view{ raw, script_info::query(name) }
+	inline script_view::script_view(const std::span<uint8_t> raw, const std::string_view name, std::pmr::memory_resource* resource)
+		:script_view{ raw, script_info::query(name), resource }
 	{
 	}
 
@@ -351,15 +537,40 @@ namespace mes
 		return this->m_labels;
 	}
 
-	inline auto script_view::tokens() const noexcept -> const std::vector<token>&
+	inline auto script_view::tokens() const noexcept -> const std::pmr::vector<token>&
 	{
 		return this->m_tokens;
 	}
 
+	inline auto script_view::texts() const noexcept -> const std::pmr::vector<uint32_t>&
+	{
+		return this->m_texts;
+	}
+
 	inline auto script_view::version() const noexcept -> uint16_t
 	{
 		return this->m_version;
 	}
+
+	inline auto script_stream::prefix() noexcept -> std::span<uint8_t>
+	{
+		return { this->m_buffer.data(), this->m_base == 0 ? this->m_count : 0 };
+	}
+
+	inline auto script_stream::info() const noexcept -> const script_info*
+	{
+		return this->m_info;
+	}
+
+	inline auto script_stream::asmbin_offset() const noexcept -> int32_t
+	{
+		return this->m_asmbin;
+	}
+
+	inline auto script_stream::completed() const noexcept -> bool
+	{
+		return this->m_finished && !this->m_failed;
+	}
 	
 	inline auto unionmes_view::advtxt_view() const noexcept -> const mes::advtxt_view*
 	{
@@ -579,6 +790,11 @@ namespace mes
 		return "";
 	}
 
+	inline auto script_helper::unmatched_labels() const noexcept -> const std::vector<size_t>&
+	{
+		return this->m_unmatched_labels;
+	}
+
 	inline auto script_helper::data_view() const noexcept -> const unionmes_view&
 	{
 		return this->m_data_view;
@@ -595,6 +811,49 @@ namespace mes
 		return *this;
 	}
 
+	inline auto script_helper::use_resource(std::pmr::memory_resource* resource) noexcept -> mes::script_helper&
+	{
+		// 旧视图的 token 表属于原来的 resource，先释放掉，避免之后移动赋值时跨 resource 逐个复制
+		this->m_data_view = nullptr;
+		this->m_resource  = resource != nullptr ? resource : std::pmr::get_default_resource();
+		return *this;
+	}
+
+	inline auto script_helper::use_detector(script_detector* detector) noexcept -> mes::script_helper&
+	{
+		this->m_detector = detector;
+		return *this;
+	}
+
+	inline auto script_helper::use_pool(const bool enable) noexcept -> mes::script_helper&
+	{
+		this->m_pooled = enable;
+		return *this;
+	}
+
+	inline auto script_helper::acquire_buffer(const size_t size) -> xmem::buffer<uint8_t>
+	{
+		if (this->m_pooled)
+		{
+			return xmem::buffer_pool<uint8_t>::shared().acquire(size);
+		}
+		xmem::buffer<uint8_t> result{};
+		result.resize(size, false);
+		return result;
+	}
+
+	inline auto script_helper::release_buffer(xmem::buffer<uint8_t>&& buffer) noexcept -> void
+	{
+		if (this->m_pooled)
+		{
+			xmem::buffer_pool<uint8_t>::shared().release(std::move(buffer));
+		}
+		else
+		{
+			buffer = xmem::buffer<uint8_t>{};
+		}
+	}
+
 	namespace script 
 	{
 		using info   = script_info;
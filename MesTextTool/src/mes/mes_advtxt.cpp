@@ -1,7 +1,13 @@
+#include <bit>
 #include <iostream>
 #include <mes_advtxt.hpp>
 #include <xstr.hpp>
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define _mes_advtxt_sse2_
+#endif
+
 namespace mes::advtxt
 {
 
@@ -19,6 +25,25 @@ namespace mes::advtxt
 		{ "suikademo", { 0x00, 0x16 } }, // 水夏ちょこっと体験版
 	};
 
+	static auto make_encstrs_set(const std::vector<uint8_t>& encstrs) noexcept -> std::bitset<0x100>
+	{
+		std::bitset<0x100> result{};
+		for (const uint8_t opcode : encstrs)
+		{
+			result.set(opcode);
+		}
+		return result;
+	}
+
+	[[maybe_unused]] static auto __advtxt_infos_init__ = []()
+	{
+		for (const auto& info : advtxt_info::infos())
+		{
+			info.encstrs_set = make_encstrs_set(info.encstrs);
+		}
+		return true;
+	}();
+
 	auto advtxt_info::supports() -> const std::span<const char*>
 	{
 		return std::span<const char*>
@@ -33,9 +58,10 @@ namespace mes::advtxt
 		return advtxt_info::advtxt_infos;
 	}
 
-	inline auto advtxt_info::set(std::vector<uint8_t>&& encstrs) const noexcept -> void
+	inline auto advtxt_info::set(std::vector<uint8_t>&& encstrs) noexcept -> void
 	{
-		*const_cast<std::vector<uint8_t>*>(&this->encstrs) = std::move(encstrs);
+		this->encstrs = std::move(encstrs);
+		this->encstrs_set = make_encstrs_set(this->encstrs);
 	}
 
 	auto advtxt_info::parse(std::string_view data) -> const advtxt_info*
@@ -65,26 +91,20 @@ namespace mes::advtxt
 			return nullptr;
 		}
 
-		const std::vector<xstr::view<char>> parts
-		{
-			xstr::view(data.substr(eq_pos)).split(',')
-		};
-
-		if (parts.empty() || parts.size() < 3)
-		{
-			return nullptr;
-		}
+		// 名称后面至少要有两个操作码
+		const auto parts{ xstr::view(data.substr(eq_pos)).lazy_split(',') };
+		auto part{ parts.begin() };
 
-		std::string_view name{ xstr::trim(parts[0]) };
+		std::string_view name{ xstr::trim(*part) };
 		if (name.empty())
 		{
 			return nullptr;
 		}
 
 		std::vector<uint8_t> encstrs{};
-		for (size_t i{ 1 }; i < parts.size(); i++)
+		for (++part; part != parts.end(); ++part)
 		{
-			const auto numstr{ xstr::trim(parts[i]) };
+			const auto numstr{ xstr::trim(*part) };
 			if (numstr.empty())
 			{
 				return nullptr;
@@ -99,7 +119,12 @@ namespace mes::advtxt
 			encstrs.push_back(value.value());
 		}
 
-		for (const auto& info : advtxt_info::advtxt_infos)
+		if (encstrs.size() < 2)
+		{
+			return nullptr;
+		}
+
+		for (auto& info : advtxt_info::advtxt_infos)
 		{
 			if (info.name != name)
 			{
@@ -109,10 +134,12 @@ namespace mes::advtxt
 			return &info;
 		}
 
+		const std::bitset<0x100> encstrs_set{ make_encstrs_set(encstrs) };
 		advtxt_info::advtxt_infos.push_back(advtxt_info
 		{
-			.name    = std::string{ name },
-			.encstrs = std::move(encstrs)
+			.name        = std::string{ name },
+			.encstrs     = std::move(encstrs),
+			.encstrs_set = encstrs_set
 		});
 
 		return &advtxt_info::advtxt_infos.back();
@@ -150,8 +177,9 @@ namespace mes::advtxt
 
 		advtxt_infos.push_back(advtxt_info
 		{
-			.name    = std::string{ name },
-			.encstrs = advtxt_info::advtxt_infos[0].encstrs
+			.name        = std::string{ name },
+			.encstrs     = advtxt_info::advtxt_infos[0].encstrs,
+			.encstrs_set = advtxt_info::advtxt_infos[0].encstrs_set
 		});
 
 		return &advtxt_infos.back();
@@ -160,7 +188,7 @@ namespace mes::advtxt
 	auto advtxt_info::make(std::string_view name, std::vector<uint8_t>&& encstrs) -> const advtxt_info*
 	{
 
-		for (const auto& info : advtxt_info::advtxt_infos)
+		for (auto& info : advtxt_info::advtxt_infos)
 		{
 			if (info.name != name)
 			{
@@ -170,17 +198,19 @@ namespace mes::advtxt
 			return &info;
 		}
 
+		const std::bitset<0x100> encstrs_set{ make_encstrs_set(encstrs) };
 		advtxt_infos.push_back(advtxt_info
 		{
-			.name    = std::string{ name },
-			.encstrs = std::move(encstrs)
+			.name        = std::string{ name },
+			.encstrs     = std::move(encstrs),
+			.encstrs_set = encstrs_set
 		});
 
 		return &advtxt_infos.back();
 	}
 
-	advtxt_view::advtxt_view(const std::span<uint8_t> raw, const advtxt_info* info) noexcept
-		: m_raw{ raw, 0x00 }, m_info{ info }
+	advtxt_view::advtxt_view(const std::span<uint8_t> raw, const advtxt_info* info, std::pmr::memory_resource* resource) noexcept
+		: m_raw{ raw, 0x00 }, m_info{ info }, m_tokens{ resource }
 	{
 		if (this->m_raw.size() < sizeof(mes::advtxt::magic) || this->m_raw.data() == nullptr)
 		{
@@ -225,6 +255,43 @@ namespace mes::advtxt
 		this->token_parse();
 	}
 
+	// 按顺序找出所有 0A0D 结束符的位置并交给 callback；
+	// 0x0A 与 0x0D 不同，两个相邻的结束符不可能重叠，因此逐个匹配与一次扫描的结果相同
+	template<class callback_t>
+	static auto endtoken_scan(const std::span<const uint8_t> data, callback_t&& callback) noexcept -> void
+	{
+		size_t index{};
+
+		#ifdef _mes_advtxt_sse2_
+		const __m128i first { _mm_set1_epi8(static_cast<char>(mes::advtxt::endtoken[0])) };
+		const __m128i second{ _mm_set1_epi8(static_cast<char>(mes::advtxt::endtoken[1])) };
+		// 同时加载 [i, i + 16) 与 [i + 1, i + 17)，两者逐字节比较后相与即为结束符的起始位置
+		for (; index + 17 <= data.size(); index += 16)
+		{
+			const __m128i lo{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + index)) };
+			const __m128i hi{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + index + 1)) };
+			auto mask = static_cast<uint32_t>
+			(
+				_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(lo, first), _mm_cmpeq_epi8(hi, second)))
+			);
+			while (mask != 0)
+			{
+				callback(index + static_cast<size_t>(std::countr_zero(mask)));
+				mask &= mask - 1;
+			}
+		}
+		#endif
+
+		for (; index + 1 < data.size(); index++)
+		{
+			if (data[index] == mes::advtxt::endtoken[0] && data[index + 1] == mes::advtxt::endtoken[1])
+			{
+				callback(index);
+				index++;
+			}
+		}
+	}
+
 	auto advtxt_view::token_parse() noexcept -> void
 	{
 		this->m_tokens.clear();
@@ -234,15 +301,14 @@ namespace mes::advtxt
 			return;
 		}
 
+		// 先数一遍结束符，一次性预留好 token 的空间
+		size_t count{};
+		endtoken_scan(this->m_asmbin, [&count](size_t) { count++; });
+		this->m_tokens.reserve(count);
+
 		size_t current{};
-		while (true)
+		endtoken_scan(this->m_asmbin, [this, &current](size_t token_end) // 0A0D -> \n\r
 		{
-			const size_t token_end{ this->m_asmbin.find(current, mes::advtxt::endtoken) }; // 0A0D -> \n\r
-			if (token_end == view_t<uint8_t>::nops)
-			{
-				break;
-			}
-
 			this->m_tokens.push_back
 			(
 				advtxt::token
@@ -252,14 +318,8 @@ namespace mes::advtxt
 					.length = static_cast<int32_t>(token_end - current)
 				}
 			);
-
 			current = token_end + 2;
-
-			if (current >= this->m_asmbin.size())
-			{
-				break;
-			}
-		}
+		});
 	}
 
 	auto is_advtxt(const std::span<const uint8_t> data) -> bool 
@@ -272,25 +332,49 @@ namespace mes::advtxt
 		return result == 0;
 	}
 
-	auto advtxt::string_encdec(const std::span<const uint8_t> str) -> std::string
+	auto advtxt::string_encdec(const std::span<const uint8_t> str, char* output) noexcept -> size_t
 	{
-		if (str.empty()) return {};
+		size_t index{};
 
-		std::string result{};
-		result.reserve(str.size());
+		#ifdef _mes_advtxt_sse2_
+		// 每次处理 16 字节（8 对），在 16 位通道内交换高低字节；
+		// 只有偶数位置上的 0x00 才是结束符，与下方的标量实现一致
+		for (; index + 16 <= str.size(); index += 16)
+		{
+			const __m128i data{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + index)) };
+			const __m128i swap{ _mm_or_si128(_mm_slli_epi16(data, 8), _mm_srli_epi16(data, 8)) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + index), swap);
 
-		for (size_t i = 0; i < str.size(); i += 2)
+			const auto zeros{ static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_setzero_si128()))) & 0x5555u };
+			if (zeros != 0)
+			{
+				return index + static_cast<size_t>(std::countr_zero(zeros));
+			}
+		}
+		#endif
+
+		size_t count{ index };
+		for (; index < str.size(); index += 2)
 		{
-			if (str[i] == 0x00)
+			if (str[index] == 0x00)
 			{
 				break;
 			}
-			if (i + 1 < str.size())
+			if (index + 1 < str.size())
 			{
-				result.push_back(static_cast<char>(str[i + 1]));
+				output[count++] = static_cast<char>(str[index + 1]);
 			}
-			result.push_back(static_cast<char>(str[i]));
+			output[count++] = static_cast<char>(str[index]);
 		}
+		return count;
+	}
+
+	auto advtxt::string_encdec(const std::span<const uint8_t> str) -> std::string
+	{
+		if (str.empty()) return {};
+
+		std::string result(str.size(), '\0');
+		result.resize(advtxt::string_encdec(str, result.data()));
 
 		return result;
 	}
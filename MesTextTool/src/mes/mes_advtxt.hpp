@@ -1,6 +1,8 @@
 #pragma once
 #include <span>
+#include <bitset>
 #include <vector>
+#include <memory_resource>
 #include <algorithm>
 
 namespace mes::advtxt
@@ -49,12 +51,13 @@ namespace mes::advtxt
 		static std::vector<advtxt_info> advtxt_infos;
 		static const char* advtxt_supports[];
 
-		auto set(std::vector<uint8_t>&& encstrs) const noexcept -> void;
+		auto set(std::vector<uint8_t>&& encstrs) noexcept -> void;
 
 	public:
 		
 		const std::string name;
-		const std::vector<uint8_t> encstrs; // the opcode for encrypted strings in scene text
+		std::vector<uint8_t>       encstrs; // the opcode for encrypted strings in scene text
+		mutable std::bitset<0x100> encstrs_set{}; // membership set of encstrs, derived from encstrs and kept in sync by parse/make/set
 
 		inline auto is_encstrs(uint8_t value) const noexcept -> bool;
 
@@ -122,19 +125,20 @@ namespace mes::advtxt
 		};
 
 		advtxt_view() noexcept = default;
-		advtxt_view(const std::span<uint8_t> raw, const advtxt_info* info) noexcept;
+		advtxt_view(const std::span<uint8_t> raw, const advtxt_info* info, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
 		inline auto is_parsed() const noexcept -> bool;
 
 		inline auto raw   () const noexcept -> const view_t<uint8_t>&;
 		inline auto asmbin() const noexcept -> const view_t<uint8_t>&;
-		inline auto tokens() const noexcept -> const std::vector<token>&;
+		inline auto tokens() const noexcept -> const std::pmr::vector<token>&;
 		inline auto info  () const noexcept -> const advtxt_info*;
 	protected:
 		const   advtxt_info*       m_info{};
 		mutable view_t<uint8_t>    m_raw {};
 		mutable view_t<uint8_t>    m_asmbin{};
-		mutable std::vector<token> m_tokens{};
+		mutable std::pmr::vector<token> m_tokens{};
 		auto token_parse() noexcept -> void;
 	};
 
@@ -153,7 +157,7 @@ namespace mes::advtxt
 		return this->m_asmbin;
 	}
 
-	inline auto advtxt_view::tokens() const noexcept -> const std::vector<token>&
+	inline auto advtxt_view::tokens() const noexcept -> const std::pmr::vector<token>&
 	{
 		return this->m_tokens;
 	}
@@ -165,7 +169,7 @@ namespace mes::advtxt
 
 	inline auto advtxt_info::is_encstrs(uint8_t value) const noexcept -> bool
 	{
-		return std::find(this->encstrs.begin(), this->encstrs.end(), value) != this->encstrs.end();
+		return this->encstrs_set.test(value);
 	}
 
 	auto is_advtxt(const std::span<const uint8_t> data) -> bool;
@@ -175,6 +179,7 @@ namespace mes::advtxt
 	inline static constexpr const uint8_t endtoken[2]{ 0x0A, 0x0D };
 	static inline constexpr const uint8_t magic[8]{ '#', 'A','D','V','_','T','X', 'T' };
 
+	auto string_encdec(const std::span<const uint8_t> str, char* output) noexcept -> size_t;
 	auto string_encdec(const std::span<const uint8_t> str) -> std::string;
 	auto string_encdec(const std::string_view str) -> std::string;
 	auto string_parse (const token& token) -> std::string;
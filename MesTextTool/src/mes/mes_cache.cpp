@@ -0,0 +1,177 @@
+#include <cstring>
+#include <format>
+#include <vector>
+#include <xstr.hpp>
+#include <mes.hpp>
+#include <mes_cache.hpp>
+
+namespace mes
+{
+	auto token_cache::hash(const std::span<const uint8_t> data) noexcept -> uint64_t
+	{
+		// 每次吃进 8 字节的乘法-移位混合，只用于识别脚本内容是否变化
+		constexpr uint64_t prime1{ 0x9E3779B97F4A7C15 };
+		constexpr uint64_t prime2{ 0xFF51AFD7ED558CCD };
+		constexpr uint64_t prime3{ 0xC4CEB9FE1A85EC53 };
+
+		uint64_t result{ prime1 ^ static_cast<uint64_t>(data.size()) };
+		size_t index{};
+		for (; index + 8 <= data.size(); index += 8)
+		{
+			uint64_t word{};
+			std::memcpy(&word, data.data() + index, sizeof(word));
+			result = (result ^ word) * prime2;
+			result ^= result >> 32;
+		}
+
+		if (index < data.size())
+		{
+			uint64_t word{};
+			std::memcpy(&word, data.data() + index, data.size() - index);
+			result = (result ^ word) * prime2;
+			result ^= result >> 32;
+		}
+
+		result ^= result >> 33;
+		result *= prime3;
+		result ^= result >> 33;
+		return result;
+	}
+
+	auto token_cache::fingerprint(const script_info& info) noexcept -> uint64_t
+	{
+		std::vector<uint8_t> data
+		{
+			static_cast<uint8_t>(info.offset),
+			static_cast<uint8_t>(info.version & 0xFF), static_cast<uint8_t>(info.version >> 8),
+			info.enckey,
+			info.uint8x2.beg,  info.uint8x2.end,
+			info.uint8str.beg, info.uint8str.end,
+			info.string.beg,   info.string.end,
+			info.encstr.beg,   info.encstr.end,
+			info.uint16x4.beg, info.uint16x4.end
+		};
+		data.insert(data.end(), info.opstrs.begin(), info.opstrs.end());
+		return token_cache::hash(data);
+	}
+
+	auto token_cache::path(const uint64_t hash, const script_info* info) const noexcept -> std::wstring
+	{
+		// 文件名带上定义指纹，同名但定义不同的 info 各自使用自己的缓存文件
+		std::wstring name{ std::format(L"{:016X}_", hash) };
+		name.append(xstr::cvt::to_utf16(info->name, CP_UTF8));
+		name.append(std::format(L"_{:016X}.tkc", token_cache::fingerprint(*info)));
+		return xfsys::path::join(this->m_directory, name);
+	}
+
+	auto token_cache::find(const uint64_t hash, const size_t source_size, const script_info* info) const noexcept -> entry
+	{
+		entry result{};
+		if (!this->enabled() || info == nullptr)
+		{
+			return result;
+		}
+
+		const std::wstring path{ this->path(hash, info) };
+		if (!xfsys::is_file(path))
+		{
+			return result;
+		}
+
+		xfsys::mapping mapping{ xfsys::open(path, xfsys::read, false) };
+		if (!mapping.is_open() || mapping.size() < sizeof(header))
+		{
+			return result;
+		}
+
+		const auto head{ reinterpret_cast<const header*>(mapping.data()) };
+		const bool is_valid
+		{
+			std::memcmp(head->magic, token_cache::magic, sizeof(token_cache::magic)) == 0 &&
+			head->version     == token_cache::version &&
+			head->hash        == hash &&
+			head->source_size == source_size &&
+			head->info        == token_cache::fingerprint(*info) &&
+			mapping.size()    == sizeof(header) +
+				static_cast<size_t>(head->token_count) * sizeof(record) +
+				static_cast<size_t>(head->text_count ) * sizeof(uint32_t) &&
+			head->checksum    == token_cache::hash({ mapping.data() + sizeof(header), mapping.size() - sizeof(header) })
+		};
+
+		if (is_valid)
+		{
+			result.m_mapping = std::move(mapping);
+		}
+		return result;
+	}
+
+	auto token_cache::store(const uint64_t hash, const script_view& view) const noexcept -> bool
+	{
+		const script_info* info{ view.info() };
+		const std::pmr::vector<mes::token>& tokens{ view.tokens() };
+		if (!this->enabled() || info == nullptr || tokens.empty())
+		{
+			return false;
+		}
+
+		std::vector<uint32_t> texts{};
+		for (size_t index{}; index < tokens.size(); index++)
+		{
+			if (info->is_text(tokens[index].opcode()))
+			{
+				texts.push_back(static_cast<uint32_t>(index));
+			}
+		}
+
+		const header head
+		{
+			.magic       = { token_cache::magic[0], token_cache::magic[1], token_cache::magic[2], token_cache::magic[3] },
+			.version     = token_cache::version,
+			.hash        = hash,
+			.source_size = view.raw().size(),
+			.info        = token_cache::fingerprint(*info),
+			.token_count = static_cast<uint32_t>(tokens.size()),
+			.text_count  = static_cast<uint32_t>(texts.size())
+		};
+
+		std::vector<uint8_t> buffer(sizeof(header) + tokens.size() * sizeof(record) + texts.size() * sizeof(uint32_t));
+
+		auto records{ reinterpret_cast<record*>(buffer.data() + sizeof(header)) };
+		for (const mes::token& token : tokens)
+		{
+			*records++ = record{ token.offset, token.length };
+		}
+		std::memcpy(records, texts.data(), texts.size() * sizeof(uint32_t));
+
+		std::memcpy(buffer.data(), &head, sizeof(header));
+		reinterpret_cast<header*>(buffer.data())->checksum = token_cache::hash
+		(
+			{ buffer.data() + sizeof(header), buffer.size() - sizeof(header) }
+		);
+
+		if (!xfsys::create_directory(this->m_directory, true))
+		{
+			return false;
+		}
+
+		// 多个线程或进程可能同时写同一份缓存：各自写入自己的临时文件，写完后整体替换，读者不会映射到写了一半的文件
+		const std::wstring path{ this->path(hash, info) };
+		const std::wstring temp{ std::format(L"{}.{}.{}.tmp", path, ::GetCurrentProcessId(), ::GetCurrentThreadId()) };
+		bool completed{};
+		{
+			const xfsys::file file{ xfsys::create(temp) };
+			if (!file.is_open())
+			{
+				return false;
+			}
+			completed = file.write(buffer, xfsys::file::pos::begin) == buffer.size();
+		}
+
+		if (!completed || !xfsys::rename(temp, path))
+		{
+			xfsys::remove(temp);
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <span>
+#include <string>
+#include <xfsys.hpp>
+
+namespace mes
+{
+	struct script_info;
+	class  script_view;
+
+	// 按脚本内容的哈希与 script_info 的名称及定义指纹，把 token 表与文本条目所在的 token 下标保存到磁盘，
+	// 命中时只需映射一次缓存文件；文件布局：[header] [record * token_count] [uint32_t * text_count]。
+	// 缓存只由 store 从完整解析的结果写出，先写临时文件再替换，find 校验过 header 与 checksum 后内容即可直接使用
+	class token_cache
+	{
+	public:
+
+		#pragma pack(push, 1)
+		struct header
+		{
+			uint8_t  magic[4];
+			uint32_t version;
+			uint64_t hash;        // 脚本内容的哈希
+			uint64_t source_size; // 脚本的字节数
+			uint64_t info;        // script_info 定义的指纹，同名的 info 被重新定义后旧缓存不再使用
+			uint32_t token_count;
+			uint32_t text_count;
+			uint64_t checksum;    // header 之后全部内容的哈希
+		};
+		#pragma pack(pop)
+
+		#pragma pack(push, 1)
+		struct record
+		{
+			int32_t offset, length;
+		};
+		#pragma pack(pop)
+
+		inline static constexpr uint8_t  magic[4]{ 'M', 'T', 'K', 'C' };
+		inline static constexpr uint32_t version { 0x03 }; // 布局变化时递增，旧的缓存文件会被忽略
+
+		class entry
+		{
+			friend token_cache;
+			xfsys::mapping m_mapping{};
+
+		public:
+
+			inline auto empty () const noexcept -> bool;
+			inline auto tokens() const noexcept -> std::span<const record>;
+			inline auto texts () const noexcept -> std::span<const uint32_t>;
+		};
+
+		inline token_cache() noexcept = default;
+		inline token_cache(const std::wstring_view directory) noexcept : m_directory{ directory } {};
+
+		inline auto enabled() const noexcept -> bool;
+		inline auto directory() const noexcept -> std::wstring_view;
+
+		auto find (const uint64_t hash, const size_t source_size, const script_info* info) const noexcept -> entry;
+		auto store(const uint64_t hash, const script_view& view) const noexcept -> bool;
+
+		static auto hash(const std::span<const uint8_t> data) noexcept -> uint64_t;
+
+		// 覆盖布局、版本、enckey、各指令区间与 opstrs，任何一项变化都会使 token 长度或文本判定改变
+		static auto fingerprint(const script_info& info) noexcept -> uint64_t;
+
+	protected:
+
+		auto path(const uint64_t hash, const script_info* info) const noexcept -> std::wstring;
+
+		std::wstring m_directory{};
+	};
+
+	inline auto token_cache::entry::empty() const noexcept -> bool
+	{
+		return !this->m_mapping.is_open();
+	}
+
+	inline auto token_cache::entry::tokens() const noexcept -> std::span<const record>
+	{
+		if (this->empty())
+		{
+			return {};
+		}
+		const auto head{ reinterpret_cast<const header*>(this->m_mapping.data()) };
+		return { reinterpret_cast<const record*>(head + 1), head->token_count };
+	}
+
+	inline auto token_cache::entry::texts() const noexcept -> std::span<const uint32_t>
+	{
+		if (this->empty())
+		{
+			return {};
+		}
+		const auto head{ reinterpret_cast<const header*>(this->m_mapping.data()) };
+		const auto data{ reinterpret_cast<const record*>(head + 1) + head->token_count };
+		return { reinterpret_cast<const uint32_t*>(data), head->text_count };
+	}
+
+	inline auto token_cache::enabled() const noexcept -> bool
+	{
+		return !this->m_directory.empty();
+	}
+
+	inline auto token_cache::directory() const noexcept -> std::wstring_view
+	{
+		return this->m_directory;
+	}
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <mes_cipher.hpp>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define _mes_cipher_sse2_
+#endif
+
+namespace mes::cipher
+{
+	template<bool subtract>
+	static inline auto transform(const uint8_t* input, uint8_t* output, const size_t size, const uint8_t key) noexcept -> void
+	{
+		size_t index{};
+
+		#ifdef _mes_cipher_sse2_
+		const __m128i keys{ _mm_set1_epi8(static_cast<char>(key)) };
+		for (; index + 16 <= size; index += 16)
+		{
+			const __m128i data{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + index)) };
+			const __m128i result
+			{
+				subtract ?
+				_mm_sub_epi8(data, keys) :
+				_mm_add_epi8(data, keys)
+			};
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + index), result);
+		}
+		#endif
+
+		for (; index < size; index++)
+		{
+			output[index] = static_cast<uint8_t>(subtract ? input[index] - key : input[index] + key);
+		}
+	}
+
+	auto add(const uint8_t* input, uint8_t* output, const size_t size, const uint8_t key) noexcept -> void
+	{
+		cipher::transform<false>(input, output, size, key);
+	}
+
+	auto sub(const uint8_t* input, uint8_t* output, const size_t size, const uint8_t key) noexcept -> void
+	{
+		cipher::transform<true>(input, output, size, key);
+	}
+}
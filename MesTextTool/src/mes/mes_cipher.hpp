@@ -0,0 +1,22 @@
+#pragma once
+#include <span>
+#include <cstdint>
+
+namespace mes::cipher
+{
+	// output[i] = input[i] + key，input 与 output 可以是同一块内存
+	auto add(const uint8_t* input, uint8_t* output, const size_t size, const uint8_t key) noexcept -> void;
+
+	// output[i] = input[i] - key，input 与 output 可以是同一块内存
+	auto sub(const uint8_t* input, uint8_t* output, const size_t size, const uint8_t key) noexcept -> void;
+
+	inline auto add(const std::span<uint8_t> data, const uint8_t key) noexcept -> void
+	{
+		cipher::add(data.data(), data.data(), data.size(), key);
+	}
+
+	inline auto sub(const std::span<uint8_t> data, const uint8_t key) noexcept -> void
+	{
+		cipher::sub(data.data(), data.data(), data.size(), key);
+	}
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <algorithm> 
 #include <ranges>
+#include <functional>
 #include <xstr.hpp>
 #include <console.hpp>
 #include <mes.hpp>
@@ -24,8 +25,9 @@ namespace mes
 
 		if (file_size > this->m_buffer.size())
 		{
-			this->m_buffer.clear();
-			this->m_buffer.resize(file_size);
+			// 换一块足够大的 buffer，旧的交回池中给后续较小的文件使用
+			this->release_buffer(std::move(this->m_buffer));
+			this->m_buffer = this->acquire_buffer(file_size);
 		}
 
 		const size_t bytes_read{ file.read(this->m_buffer, file_size, xfsys::file::pos::begin, 0) };
@@ -41,16 +43,33 @@ namespace mes
 				this->m_data_view = mes::advtxt_view
 				{
 					std::span<uint8_t>{ this->m_buffer.data(), file_size },
-					this->m_view_info.advtxt_info()
+					this->m_view_info.advtxt_info(),
+					this->m_resource
 				};
 			}
 			else 
 			{
-				this->m_data_view = mes::script_view
+				const std::span<uint8_t> data{ this->m_buffer.data(), file_size };
+				const mes::script_info* info{ this->m_view_info.script_info() };
+				if (info == nullptr)
 				{
-					std::span<uint8_t>{ this->m_buffer.data(), file_size },
-					this->m_view_info.script_info()
-				};
+					info = this->detect(data);
+				}
+
+				if (this->m_cache.enabled() && info != nullptr)
+				{
+					const uint64_t hash{ token_cache::hash(data) };
+					const token_cache::entry cached{ this->m_cache.find(hash, file_size, info) };
+					this->m_data_view = mes::script_view{ data, info, cached, this->m_resource };
+					if (cached.empty())
+					{
+						this->m_cache.store(hash, *this->m_data_view.script_view());
+					}
+				}
+				else
+				{
+					this->m_data_view = mes::script_view{ data, info, this->m_resource };
+				}
 			}
 		}
 
@@ -73,6 +92,7 @@ namespace mes
 			return *this;
 		}
 
+		this->m_directory.assign(xfsys::path::parent(path));
 		return { this->load(xfsys::open(path, xfsys::read, false)) };
 	}
 
@@ -90,6 +110,7 @@ namespace mes
 			return *this;
 		}
 
+		this->m_directory.assign(xstr::cvt::to_utf16(xfsys::path::parent(path)));
 		return { this->load(xfsys::open(path, xfsys::read, false)) };
 	}
 
@@ -110,6 +131,7 @@ namespace mes
 			path.assign(xfsys::path::join(directory, name));
 		}
 
+		this->m_directory.assign(directory);
 		return this->load(xfsys::open(path, xfsys::read, false));
 	}
 
@@ -118,6 +140,56 @@ namespace mes
 		return this->load(xstr::cvt::to_utf16(directory), xstr::cvt::to_utf16(name));
 	}
 
+	auto script_helper::use_cache(const std::wstring_view directory) noexcept -> script_helper&
+	{
+		this->m_cache = token_cache{ directory };
+		return *this;
+	}
+
+	auto script_helper::detect(const std::span<uint8_t> data) noexcept -> const script_info*
+	{
+		if (this->m_detector == nullptr)
+		{
+			return script_info::detect(data);
+		}
+		return this->m_detector->detect(this->m_directory, data);
+	}
+
+	auto script_detector::detect(const std::wstring_view directory, const std::span<uint8_t> data) noexcept -> const script_info*
+	{
+		const std::vector<const script_info*> candidates{ script_info::candidates(data) };
+		if (candidates.size() <= 1)
+		{
+			return candidates.empty() ? nullptr : candidates.front();
+		}
+
+		// 以目录和首个候选作为键：同一目录中版本号相同的文件共用一次识别结果；std::map 的节点地址不变，
+		// 试解析打分较慢，放在锁外进行，几个线程同时打分时都会投票，结果不受影响
+		detection* state{};
+		{
+			const std::lock_guard<std::mutex> lock{ this->m_mutex };
+			state = &this->m_detected[{ std::wstring{ directory }, candidates.front() }];
+			if (state->info != nullptr)
+			{
+				return state->info;
+			}
+		}
+
+		const script_info* const best{ script_info::detect(data, candidates) };
+
+		const std::lock_guard<std::mutex> lock{ this->m_mutex };
+		auto it{ std::ranges::find(state->votes, best, &std::pair<const script_info*, uint32_t>::first) };
+		if (it == state->votes.end())
+		{
+			it = state->votes.insert(it, { best, 0 });
+		}
+		if (++it->second >= script_detector::samples && state->info == nullptr)
+		{
+			state->info = best;
+		}
+		return best;
+	}
+
 	auto script_helper::save(const xfsys::file& file) noexcept -> bool
 	{
 		if (!file.is_open())
@@ -180,12 +252,19 @@ namespace mes
 
 	auto script_helper::export_text(const bool absolute_file_offset) const noexcept -> std::vector<text::entry>
 	{
-		std::vector<text::entry> result{};
-		if (!this->script_export(result, absolute_file_offset))
+		text::entries result{};
+		this->export_text(result, absolute_file_offset);
+		return result.to_vector();
+	}
+
+	auto script_helper::export_text(text::entries& output, const bool absolute_file_offset) const noexcept -> bool
+	{
+		output.clear();
+		return bool
 		{
-			this->advtxt_export(result, absolute_file_offset);
-		}
-		return result;
+			this->script_export(output, absolute_file_offset) ? true :
+			this->advtxt_export(output, absolute_file_offset)
+		};
 	}
 	
 	#ifdef _DEBUG
@@ -207,7 +286,7 @@ namespace mes
 	}
 	#endif
 
-	auto script_helper::script_export(std::vector<text::entry>& texts, bool absolute_file_offset) const noexcept -> bool
+	auto script_helper::script_export(text::entries& texts, bool absolute_file_offset) const noexcept -> bool
 	{
 		const mes::script_view* script_view{ this->m_data_view.script_view() };
 		if (script_view == nullptr)
@@ -217,14 +296,56 @@ namespace mes
 		else 
 		{
 			texts.clear();
+			texts.source(script_view->raw());
 		}
 
 		const mes::script_info* info{ script_view->info() };
 		const mes::script_view::view_t<uint8_t>& asmbin{ script_view->asmbin() };
-		const std::vector<mes::token>& tokens{ script_view->tokens() };
+		const std::pmr::vector<mes::token>& tokens{ script_view->tokens() };
+
+		const auto is_opstr = [info](const mes::token& token) -> bool
+		{
+			return token.opcode() != 0x00 && info->is_opstrs(token.opcode());
+		};
+
+		// 从缓存载入时已经知道哪些 token 是文本，只需遍历这些 token
+		const auto for_each_token = [&tokens, script_view](auto&& callback) -> void
+		{
+			if (!script_view->texts().empty())
+			{
+				for (const uint32_t index : script_view->texts())
+				{
+					callback(tokens[index]);
+				}
+			}
+			else
+			{
+				for (const mes::token& token : tokens)
+				{
+					callback(token);
+				}
+			}
+		};
+
+		{
+			// 预先统计条目数量以及需要解密的字节数，使存储只需分配一次
+			size_t count{}, bytes{};
+			for_each_token([&](const mes::token& token) -> void
+			{
+				if (info->encstr.is(token.opcode()))
+				{
+					count++, bytes += static_cast<size_t>(token.length);
+				}
+				else if (is_opstr(token))
+				{
+					count++;
+				}
+			});
+			texts.reserve(count, bytes);
+		}
 
 		const int32_t base{ absolute_file_offset ? asmbin.offset() : 0 };
-		for (const mes::token& token : tokens)
+		for_each_token([&](const mes::token& token) -> void
 		{
 			#ifdef _DEBUG
 			if (info->string.is(token.opcode()))
@@ -233,28 +354,92 @@ namespace mes
 			}
 			#endif
 
+			if (token.length < 2)
+			{
+				return;
+			}
+
+			const auto offset{ static_cast<int32_t>(token.offset + base) };
+			const std::string_view string
+			{
+				reinterpret_cast<const char*>(token.data + 1),
+				static_cast<size_t>(token.length - 2)
+			};
+
 			if (info->encstr.is(token.opcode()))
 			{
-				std::string  text{ token.encstr()->str };
-				const auto offset{ static_cast<int32_t>(token.offset + base) };
+				const std::span<char> text{ texts.allocate(offset, string.size()) };
+				info->decrypt(std::span{ token.data + 1, string.size() }, reinterpret_cast<uint8_t*>(text.data())); // 解密字符串
+			}
+			else if (is_opstr(token))
+			{
+				texts.push_view(offset, string); // 未加密的字符串直接引用脚本缓冲区
+			}
+		});
+		return true;
+	}
+
+	auto script_helper::stream_begin(script_stream& stream, const std::wstring_view directory) noexcept -> bool
+	{
+		this->m_data_view = nullptr;
+		this->m_directory.assign(directory);
 
-				std::ranges::for_each(text, [&](char& ch) {
-					ch += script_view->info()->enckey; // 解密字符串
-				});
+		const std::span<uint8_t> prefix{ stream.prefix() };
+		if (prefix.empty() || this->m_view_info.advtxt_info() != nullptr || mes::advtxt::is_advtxt(prefix))
+		{
+			return false;
+		}
 
-				texts.push_back(text::entry{ offset, text });
+		const mes::script_info* info{ this->m_view_info.script_info() };
+		if (info == nullptr)
+		{
+			info = this->detect(prefix);
+		}
+		return stream.begin(info);
+	}
+
+	auto script_helper::stream_export(script_stream& stream, text::dump_writer& writer, const bool absolute_file_offset) noexcept -> bool
+	{
+		const mes::script_info* info{ stream.info() };
+		if (info == nullptr)
+		{
+			return false;
+		}
+
+		// 与 script_export 相同：长度不小于 2 的 encstr 与 opstrs 都占一个编号，空文本只是不写出
+		std::string decrypted{};
+		size_t number{};
+		const int32_t base{ absolute_file_offset ? stream.asmbin_offset() : 0 };
+		for (mes::token token{}; stream.next(token); )
+		{
+			if (token.length < 2)
+			{
+				continue;
 			}
-			else if (token.opcode() != 0x00 && std::ranges::contains(info->opstrs, token.opcode()))
+
+			const auto offset{ static_cast<int32_t>(token.offset + base) };
+			const std::string_view string
 			{
-				std::string  text{ token.string()->str };
-				const auto offset{ static_cast<int32_t>(token.offset + base) };
-				texts.push_back(text::entry{ offset, text });
+				reinterpret_cast<const char*>(token.data + 1),
+				static_cast<size_t>(token.length - 2)
+			};
+
+			if (info->encstr.is(token.opcode()))
+			{
+				decrypted.resize(string.size());
+				info->decrypt(std::span{ token.data + 1, string.size() }, reinterpret_cast<uint8_t*>(decrypted.data()));
+				writer.write(++number, offset, decrypted);
+			}
+			else if (token.opcode() != 0x00 && info->is_opstrs(token.opcode()))
+			{
+				writer.write(++number, offset, string);
 			}
 		}
-		return true;
+
+		return stream.completed() && writer.flush();
 	}
 
-	auto script_helper::advtxt_export(std::vector<text::entry>& texts, bool absolute_file_offset) const noexcept -> bool
+	auto script_helper::advtxt_export(text::entries& texts, bool absolute_file_offset) const noexcept -> bool
 	{
 		const mes::advtxt::info* info{ this->m_view_info.advtxt_info() };
 		if (info != nullptr)
@@ -267,7 +452,18 @@ namespace mes
 			}
 
 			const int32_t base{ absolute_file_offset ? advtxt_view->asmbin().offset() : 0 };
-			const std::vector<mes::advtxt_view::token>& tokens{ advtxt_view->tokens() };
+			const std::pmr::vector<mes::advtxt_view::token>& tokens{ advtxt_view->tokens() };
+			{
+				size_t count{}, bytes{};
+				for (const mes::advtxt_view::token& token : tokens)
+				{
+					if (info->is_encstrs(token->opcode))
+					{
+						count++, bytes += static_cast<size_t>(token.length);
+					}
+				}
+				texts.reserve(count, bytes);
+			}
 
 			for (const mes::advtxt_view::token& token : tokens)
 			{
@@ -276,9 +472,16 @@ namespace mes
 					continue;
 				}
 
-				std::string  text{ mes::advtxt::string_parse(token) };
 				const auto offset{ static_cast<int32_t>(token.offset + base) };
-				texts.push_back(text::entry{ offset, text });
+				if (token.data == nullptr || token.length <= 1)
+				{
+					texts.allocate(offset, 0);
+					continue;
+				}
+
+				const std::span<const uint8_t> string{ token.data + 1, static_cast<size_t>(token.length - 1) };
+				const std::span<char> text{ texts.allocate(offset, string.size()) };
+				texts.shrink_back(mes::advtxt::string_encdec(string, text.data()));
 			}
 			return true;
 		}
@@ -286,20 +489,153 @@ namespace mes
 		return false;
 	}
 
+	auto script_helper::entry_text(const text::entry& entry, uint32_t use_code_page, std::string& converted) noexcept -> std::string_view
+	{
+		const std::string* const entry_string{ entry.string() };
+		if (entry_string != nullptr && !entry_string->empty())
+		{
+			return *entry_string;
+		}
+
+		const std::wstring* const entry_wstring{ entry.wstring() };
+		if (entry_wstring != nullptr && !entry_wstring->empty())
+		{
+			converted.clear();
+			xstr::encoding_convert(*entry_wstring, converted, use_code_page);
+			return converted;
+		}
+
+		return {};
+	}
+
+	// 译文通常与 token 同序，先从上一次命中的位置往后找，找不到再从头找
+	template<class range_t, class projection_t>
+	static auto find_text(const range_t& range, size_t& cursor, const int32_t offset, projection_t&& projection) noexcept -> size_t
+	{
+		for (size_t index{ cursor }; index < range.size(); index++)
+		{
+			if (std::invoke(projection, range[index]) == offset)
+			{
+				return (cursor = index + 1) - 1;
+			}
+		}
+		for (size_t index{}; index < cursor && index < range.size(); index++)
+		{
+			if (std::invoke(projection, range[index]) == offset)
+			{
+				return (cursor = index + 1) - 1;
+			}
+		}
+		return static_cast<size_t>(-1);
+	}
+
 	auto script_helper::import_text(const std::vector<text::entry>& texts, uint32_t use_code_page, bool absolute_file_offset) noexcept -> bool
 	{
 		if (texts.empty())
 		{
 			return false;
 		}
+
+		const auto lookup = [&texts, use_code_page, cursor = size_t{}](const int32_t offset, std::string& converted) mutable -> std::string_view
+		{
+			const size_t index{ find_text(texts, cursor, offset, &text::entry::offset) };
+			if (index == static_cast<size_t>(-1))
+			{
+				return {};
+			}
+			return script_helper::entry_text(texts[index], use_code_page, converted);
+		};
+
+		return bool
+		{
+			this->script_import(lookup, absolute_file_offset) ? true :
+			this->advtxt_import(lookup, absolute_file_offset)
+		};
+	}
+
+	auto script_helper::import_text(const text::entries& texts, uint32_t texts_code_page, uint32_t use_code_page, bool absolute_file_offset) noexcept -> bool
+	{
+		if (texts.empty())
+		{
+			return false;
+		}
+
+		// 代码页一致时直接使用 texts 中的视图，不做任何复制
+		const auto lookup = [&texts, texts_code_page, use_code_page, cursor = size_t{}](const int32_t offset, std::string& converted) mutable -> std::string_view
+		{
+			const std::pmr::vector<text::entries::handle>& handles{ texts.handles() };
+			const size_t index{ find_text(handles, cursor, offset, &text::entries::handle::offset) };
+			if (index == static_cast<size_t>(-1))
+			{
+				return {};
+			}
+
+			const std::string_view text{ texts.text(handles[index]) };
+			if (text.empty() || texts_code_page == use_code_page)
+			{
+				return text;
+			}
+			converted.clear();
+			xstr::encoding_convert(text, converted, texts_code_page, use_code_page);
+			return converted;
+		};
+
 		return bool
 		{
-			this->script_import(texts, use_code_page, absolute_file_offset) ? true :
-			this->advtxt_import(texts, use_code_page, absolute_file_offset)
+			this->script_import(lookup, absolute_file_offset) ? true :
+			this->advtxt_import(lookup, absolute_file_offset)
 		};
 	}
 
-	auto script_helper::script_import(const std::vector<text::entry>& texts, uint32_t use_code_page, bool absolute_file_offset) noexcept -> bool
+	auto script_helper::label_tokens(const mes::script_view& view, std::vector<size_t>& unmatched) noexcept -> std::vector<size_t>
+	{
+		const std::pmr::vector<mes::token>& tokens{ view.tokens() };
+		const mes::script_view::view_t<int32_t>& labels{ view.labels() };
+
+		std::vector<size_t> result(labels.size(), script_helper::no_token);
+		unmatched.clear();
+
+		if (labels.offset() == 0x04)
+		{
+			// label 的值为目标 token 的 offset 加上版本号所占的字节数
+			const int32_t first_token_bytes{ view.info()->version & 0xFF00u ? 0x02 : 0x01 };
+			for (size_t index{}; index < labels.size(); index++)
+			{
+				const int32_t target{ labels[index] - first_token_bytes };
+				const auto it{ std::ranges::lower_bound(tokens, target, std::less{}, &mes::token::offset) };
+				if (it != tokens.end() && it->offset == target)
+				{
+					result[index] = static_cast<size_t>(std::distance(tokens.begin(), it));
+				}
+				else
+				{
+					unmatched.push_back(index);
+				}
+			}
+		}
+		else if (labels.offset() == 0x08)
+		{
+			// 第 n 个 label 对应第 n 条 0x03/0x04 指令，值为该指令结束的位置
+			size_t index{};
+			for (size_t token_index{}; token_index < tokens.size() && index < labels.size(); token_index++)
+			{
+				const uint8_t opcode{ tokens[token_index].opcode() };
+				if (opcode == 0x03 || opcode == 0x04)
+				{
+					result[index++] = token_index;
+				}
+			}
+			for (; index < labels.size(); index++)
+			{
+				unmatched.push_back(index);
+			}
+		}
+
+		return result;
+	}
+
+	template<class lookup_t>
+	auto script_helper::script_import(lookup_t&& lookup, bool absolute_file_offset) noexcept -> bool
 	{
 
 		const mes::script_view* script_view{ this->m_data_view.script_view() };
@@ -308,7 +644,7 @@ namespace mes
 			return false;
 		}
 
-		const std::vector<mes::token>& tokens{ script_view->tokens() };
+		const std::pmr::vector<mes::token>& tokens{ script_view->tokens() };
 		if (tokens.empty())
 		{
 			return false;
@@ -319,116 +655,85 @@ namespace mes
 		const mes::script_view::view_t<uint8_t>& asmbin{ script_view->asmbin() };
 		const mes::script_view::view_t<int32_t>& labels{ script_view->labels() };
 
-		utils::xmem::buffer<uint8_t> buffer{};
-		buffer.resize(this->m_buffer.size());
+		// 先把每个 label 对应到 token 下标，复制完成后再按新的位置统一重定位
+		const std::vector<size_t> label_tokens{ script_helper::label_tokens(*script_view, this->m_unmatched_labels) };
+		std::vector<int32_t> offsets(tokens.size() + 1); // 每个 token 在新 asmbin 中的起始位置，最后一项为总长度
+
+		utils::xmem::buffer<uint8_t> buffer{ this->acquire_buffer(this->m_buffer.size()) };
 		buffer.recount(asmbin.offset()); // 先空出头部数据的空间
 
-		size_t label_index{};
+		std::string converted{};
 		const int32_t base{ absolute_file_offset ? asmbin.offset() : 0 };
 
-		for (const mes::token& token : tokens)
+		for (size_t index{}; index < tokens.size(); index++)
 		{
-			if (labels.offset() == 0x04 && label_index < labels.size())
-			{
-				const int32_t first_token_bytes
-				{
-					labels.offset() == 0x08 ? 0x03 :
-					info->version & 0xFF00u ? 0x02 :
-					0x01
-				};
-
-				int32_t& label{ labels[label_index] };
-				if (token.offset + first_token_bytes == label)
-				{
-					int32_t  count{ static_cast<int32_t>(buffer.count()) };
-					int32_t offset{ count - asmbin.offset() + first_token_bytes };
-					label = offset;
-					label_index ++;
-				}
-			}
+			const mes::token& token{ tokens[index] };
+			offsets[index] = static_cast<int32_t>(buffer.count()) - asmbin.offset();
 
 			if (info->encstr.is(token.opcode()))
 			{
-				const auto&& it{ std::ranges::find(texts, token.offset + base, &text::entry::offset) };
-				if (it != texts.end())
+				const std::string_view text{ lookup(token.offset + base, converted) };
+				if(!text.empty())
 				{
-					std::string* const entry_string{ it->string() }, text{};
-					if (entry_string != nullptr && !entry_string->empty())
-					{
-						text.assign(*entry_string);
-					}
-					else 
-					{
-						std::wstring* const entry_wstring{ it->wstring() };
-						if (entry_wstring != nullptr && !entry_wstring->empty())
-						{
-							text.assign(xstr::encoding_convert(*entry_wstring, use_code_page));
-						}
-					}
-					if(!text.empty())
-					{
-						std::ranges::for_each(text, [&](char& ch) {
-							ch -= script_view->info()->enckey; // 加密字符串
-						});
-						buffer.write(token.opcode()).write(text).write('\0');
-						continue;
-					}
+					buffer.write(token.opcode());
+					const size_t position{ buffer.count() };
+					buffer.write(text.data(), text.size()).write('\0');
+
+					const std::span<uint8_t> string{ buffer.data() + position, text.size() };
+					info->encrypt(string, string.data()); // 加密字符串
+					continue;
 				}
 			}
-			else if (std::ranges::contains(info->opstrs, token.opcode()))
+			else if (info->is_opstrs(token.opcode()))
 			{
-				const auto&& it{ std::ranges::find(texts, token.offset + base, &text::entry::offset) };
-				if (it != texts.end())
+				const std::string_view text{ lookup(token.offset + base, converted) };
+				if (!text.empty())
 				{
-					std::string* const entry_string{ it->string() }, text{};
-					if (entry_string != nullptr && !entry_string->empty())
-					{
-						text.assign(*entry_string);
-					}
-					else 
-					{
-						std::wstring* const entry_wstring{ it->wstring() };
-						if (entry_wstring != nullptr && !entry_wstring->empty())
-						{
-							text.assign(xstr::encoding_convert(*entry_wstring, use_code_page));
-						}
-					}
-					if (!text.empty())
-					{
-						buffer.write(token.opcode()).write(text).write('\0');
-						continue;
-					}
+					buffer.write(token.opcode()).write(text.data(), text.size()).write('\0');
+					continue;
 				}
 			}
 
-			if (labels.offset() == 0x08 && (token.opcode() == 0x03 || token.opcode() == 0x04))
+			buffer.write(asmbin.data() + token.offset, token.length);
+		}
+		offsets[tokens.size()] = static_cast<int32_t>(buffer.count()) - asmbin.offset();
+
+		const int32_t first_token_bytes{ info->version & 0xFF00u ? 0x02 : 0x01 };
+		for (size_t index{}; index < labels.size(); index++)
+		{
+			const size_t token_index{ label_tokens[index] };
+			if (token_index == script_helper::no_token)
 			{
-				if (label_index < labels.size())
-				{
-					int32_t& label{ labels[label_index] };
-					int32_t  count{ static_cast<int32_t>(buffer.count())   };
-					int32_t offset{ count - asmbin.offset() + token.length };
-					label = (label & (0xFF << 0x18)) | offset;
-					label_index++;
-				}
+				continue; // 找不到对应的 token，保持原值
 			}
 
-			buffer.write(asmbin.data() + token.offset, token.length);
+			int32_t& label{ labels[index] };
+			if (labels.offset() == 0x04)
+			{
+				label = offsets[token_index] + first_token_bytes;
+			}
+			else
+			{
+				label = (label & (0xFF << 0x18)) | offsets[token_index + 1];
+			}
 		}
 
 		buffer.write(0, raw.data(), asmbin.offset());  // 写入头部数据
 
+		this->release_buffer(std::move(this->m_buffer));
 		this->m_buffer    = std::move(buffer);
 		this->m_data_view = mes::script_view
 		{
 			std::span<uint8_t>{ this->m_buffer.data(), this->m_buffer.count() },
-			this->m_view_info.script_info()
+			info,
+			this->m_resource
 		};
 
 		return true;
 	}
 
-	auto script_helper::advtxt_import(const std::vector<text::entry>& texts, uint32_t use_code_page, bool absolute_file_offset) noexcept -> bool
+	template<class lookup_t>
+	auto script_helper::advtxt_import(lookup_t&& lookup, bool absolute_file_offset) noexcept -> bool
 	{
 		const mes::advtxt_view* advtxt_view{ this->m_data_view.advtxt_view() };
 		if (advtxt_view == nullptr)
@@ -436,14 +741,14 @@ namespace mes
 			return false;
 		}
 
-		const std::vector<advtxt_view::token>& tokens{ advtxt_view->tokens() };
+		const std::pmr::vector<advtxt_view::token>& tokens{ advtxt_view->tokens() };
 		if (tokens.empty())
 		{
 			return false;
 		}
 
-		utils::xmem::buffer<uint8_t> buffer{};
-		buffer.resize(this->m_buffer.size());
+		utils::xmem::buffer<uint8_t> buffer{ this->acquire_buffer(this->m_buffer.size()) };
+		buffer.recount(0);
 
 		const mes::advtxt_info* info{ advtxt_view->info() };
 		const mes::advtxt_view::view_t<uint8_t>& asmbin{ advtxt_view->asmbin() };
@@ -452,68 +757,48 @@ namespace mes
 		// 复制头部数据
 		buffer.write(advtxt_view->raw().data(), asmbin.offset());
 
+		std::string converted{}, encoded{};
 		for (const advtxt::token& token : tokens)
 		{
 			if (info->is_encstrs(token->opcode))
 			{
-				const auto&& it{ std::ranges::find(texts, token.offset + base, &text::entry::offset) };
-				if (it != texts.end())
+				const std::string_view text{ lookup(token.offset + base, converted) };
+				if (!text.empty())
 				{
-					const std::string* entry_string{ it->string() };
-					if (entry_string != nullptr && !entry_string->empty())
+					if (text != "#pass#")
 					{
-						if (*entry_string != "#pass#")
+						// 多行译文按行拆分成多个 token，末尾的换行不产生空行
+						size_t current{};
+						do
 						{
-							const std::string text{ mes::advtxt::string_encdec(*entry_string) };
-							buffer.write(token->opcode).write(text).write(mes::advtxt::endtoken);
-						}
-						continue;
-					}
-
-					const std::wstring* entry_wstring{ it->wstring() };
-					if (entry_wstring != nullptr && !entry_wstring->empty())
-					{
-						if(*entry_wstring != L"#pass#")
-						{
-							std::string text{};
-							size_t size{ entry_wstring->size() }, current{};
-							do
+							size_t position{ text.find('\n', current) };
+							if (position == std::string_view::npos)
 							{
-								const size_t position{ entry_wstring->find(L'\n', current) };
-								if (position != std::wstring::npos)
-								{
-									std::wstring_view string{ entry_wstring->data() + current, position - current };
-									text    = std::move(xstr::encoding_convert(string, use_code_page));
-									current = position + 1;
-								}
-								else if (current < size)
-								{
-									std::wstring_view string{ entry_wstring->data() + current, size - current };
-									text    = std::move(xstr::encoding_convert(string, use_code_page));
-									current = size;
-								}
-								else 
-								{
-									break;
-								}
-								
-								text = std::move(mes::advtxt::string_encdec(text));
-								buffer.write(token->opcode).write(text).write(mes::advtxt::endtoken);
-
-							} while (current < size);
-						}
-						continue;
+								position = text.size();
+							}
+
+							encoded.resize(position - current);
+							encoded.resize(mes::advtxt::string_encdec(
+								std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(text.data() + current), position - current },
+								encoded.data()));
+							buffer.write(token->opcode).write(encoded).write(mes::advtxt::endtoken);
+
+							current = position + 1;
+						} while (current < text.size());
 					}
+					continue;
 				}
 			}
 			buffer.write(token.data, token.length).write(mes::advtxt::endtoken);
 		}
 
+		this->release_buffer(std::move(this->m_buffer));
 		this->m_buffer    = std::move(buffer);
 		this->m_data_view = mes::advtxt_view
 		{
 			std::span<uint8_t>{ this->m_buffer.data(), this->m_buffer.count() },
-			this->m_view_info.advtxt_info()
+			this->m_view_info.advtxt_info(),
+			this->m_resource
 		};
 
 		return true;
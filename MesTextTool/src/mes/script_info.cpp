@@ -2,6 +2,8 @@
 #include <optional>
 #include <algorithm> 
 #include <ranges>
+#include <execution>
+#include <unordered_map>
 #include <mes.hpp>
 #include <xstr.hpp>
 
@@ -87,10 +89,142 @@ namespace mes
 		{ "utaeho6"   , offset1, 0x2466, { 0x00, 0x2E }, { 0xFF, 0xFF }, { 0x2F, 0x4B }, { 0x4C, 0x4F }, { 0x50, 0xFF },  0x20, {/*--*/}/*---------*/}, // うたう絵本６
 	};
 
+	namespace registry
+	{
+		// 索引里保存的是 script_infos 中的下标。内置表初始化时按 version 降序排过一次，之后 parse
+		// 新增的条目只追加到末尾；同一个键只保留优先级最高的一个（version 大者优先，相同时下标小者优先），
+		// 这样查询结果与原先在有序表上线性查找时“返回第一个匹配项”完全一致
+		enum key_t : uint32_t
+		{
+			any     = 0x00000, // query(version)
+			full1   = 0x10000, // offset1，比较完整的版本号
+			masked1 = 0x20000, // offset1，版本号高字节为 0 时只比较低字节
+			full2   = 0x30000, // offset2
+		};
+
+		inline constexpr size_t nops{ static_cast<size_t>(-1) };
+
+		struct string_hash
+		{
+			using is_transparent = void;
+
+			inline auto operator()(const std::string_view str) const noexcept -> size_t
+			{
+				return std::hash<std::string_view>{}(str);
+			}
+		};
+
+		static std::unordered_map<std::string, size_t, string_hash, std::equal_to<>> names{};
+		static std::unordered_map<uint32_t, size_t> versions{};
+
+		// a 是否排在 b 前面，nops 排在最后
+		static auto precedes(const size_t a, const size_t b) noexcept -> bool
+		{
+			if (a == registry::nops) return false;
+			if (b == registry::nops) return true;
+			const auto& infos{ script_info::infos() };
+			if (infos[a].version != infos[b].version)
+			{
+				return infos[a].version > infos[b].version;
+			}
+			return a < b;
+		}
+
+		static auto first(const size_t a, const size_t b) noexcept -> size_t
+		{
+			return registry::precedes(b, a) ? b : a;
+		}
+
+		template<class map_t, class key_type>
+		static auto keep_first(map_t& map, key_type&& key, const size_t index) -> void
+		{
+			const auto&& [it, inserted] { map.try_emplace(std::forward<key_type>(key), index) };
+			if (!inserted && registry::precedes(index, it->second))
+			{
+				it->second = index;
+			}
+		}
+
+		static auto add(const script_info& info, const size_t index) -> void
+		{
+			registry::keep_first(registry::names, info.name, index);
+			registry::keep_first(registry::versions, key_t::any | info.version, index);
+			if (info.offset == script_info::offset1)
+			{
+				const uint32_t type{ (info.version & 0xFF00) == 0x00 ? key_t::masked1 : key_t::full1 };
+				registry::keep_first(registry::versions, type | info.version, index);
+			}
+			else
+			{
+				registry::keep_first(registry::versions, key_t::full2 | info.version, index);
+			}
+		}
+
+		static auto rebuild() -> void
+		{
+			const auto& infos{ script_info::infos() };
+			registry::names.clear();
+			registry::versions.clear();
+			registry::names.reserve(infos.size());
+			registry::versions.reserve(infos.size() * 2);
+			for (size_t i{ 0 }; i < infos.size(); i++)
+			{
+				registry::add(infos[i], i);
+			}
+		}
+
+		static auto find(const std::string_view name) -> size_t
+		{
+			const auto it{ registry::names.find(name) };
+			return it != registry::names.end() ? it->second : registry::nops;
+		}
+
+		static auto find(const uint32_t key) -> size_t
+		{
+			const auto it{ registry::versions.find(key) };
+			return it != registry::versions.end() ? it->second : registry::nops;
+		}
+	}
+
+	static auto make_opstrs_set(const std::vector<uint8_t>& opstrs) noexcept -> std::bitset<0x100>
+	{
+		std::bitset<0x100> result{};
+		for (const uint8_t opcode : opstrs)
+		{
+			result.set(opcode);
+		}
+		return result;
+	}
+
+	// 预先算好 256 个操作码各自的指令类型，token_parse 每条指令只需查一次表
+	static auto make_opcode_kinds(const script_info& info) noexcept -> std::array<script_info::opcode_kind, 0x100>
+	{
+		using kind = script_info::opcode_kind;
+		std::array<kind, 0x100> result{};
+		for (size_t i{ 0 }; i < result.size(); i++)
+		{
+			const uint8_t opcode{ static_cast<uint8_t>(i) };
+			result[i] =
+				info.uint8x2.is(opcode)  ? kind::uint8x2  :
+				info.uint8str.is(opcode) ? kind::uint8str :
+				info.string.is(opcode)   ? kind::string   :
+				info.encstr.is(opcode)   ? kind::encstr   :
+				info.uint16x4.is(opcode) ? kind::uint16x4 :
+				kind::unknown;
+		}
+		return result;
+	}
+
 	[[maybe_unused]] static auto __script_infos_init__ = []()
 	{
 		const auto infos{ const_cast<std::vector<script_info>*>(&script_info::infos()) };
 		std::ranges::sort(infos->begin(), infos->end(), std::greater{}, &script_info::version);
+		for (auto& info : *infos)
+		{
+			info.opstrs_set   = make_opstrs_set(info.opstrs);
+			info.opcode_kinds = make_opcode_kinds(info);
+		}
+		registry::rebuild();
 		return true;
 	}();
 
@@ -105,6 +239,8 @@ namespace mes
 		{
 			this->name.assign(other.name);
 			this->opstrs = other.opstrs;
+			this->opstrs_set = other.opstrs_set;
+			this->opcode_kinds = other.opcode_kinds;
 			auto  dst{ (void*)(&this->offset) };
 			auto  src{ (void*)(&other.offset) };
 			auto size{ size_t(&this->opstrs) - size_t(dst) };
@@ -117,10 +253,12 @@ namespace mes
 	{
 		this->name   = std::move(other.name);
 		this->opstrs = std::move(other.opstrs);
+		this->opstrs_set = make_opstrs_set(this->opstrs);
 		auto  dst{ (void*)(&this->offset) };
 		auto  src{ (void*)(&other.offset) };
 		auto size{ size_t(&this->opstrs) - size_t(dst) };
 		std::memcpy(dst, src, size);
+		this->opcode_kinds = make_opcode_kinds(*this);
 		return *this;
 	}
 
@@ -151,12 +289,27 @@ namespace mes
 			return nullptr;
 		}
 
-		const std::vector<xstr::view<char>> parts
+		// 前 14 项为固定字段，之后都是未加密字符串的操作码
+		std::array<std::string_view, 14> parts{};
+		size_t parts_count{};
+		std::vector<uint8_t> opstrs{};
+		for (const std::string_view part : xstr::view(data.substr(eq_pos)).lazy_split(','))
 		{
-			xstr::view(data.substr(eq_pos)).split(',')
-		};
+			if (parts_count < parts.size())
+			{
+				parts[parts_count++] = part;
+				continue;
+			}
+
+			std::optional value{ xstr::to_integer<uint8_t>(part, 16) };
+			if (!value.has_value())
+			{
+				return nullptr;
+			}
+			opstrs.push_back(value.value());
+		}
 
-		if (parts.empty() || parts.size() < 14)
+		if (parts_count < parts.size())
 		{
 			return nullptr;
 		}
@@ -210,20 +363,6 @@ namespace mes
 			values[i] = value.value();
 		}
 
-		std::vector<uint8_t> opstrs{};
-		if (parts.size() > 14)
-		{
-			for (size_t i{ 14 }; i < parts.size(); i++)
-			{
-				std::optional value{ xstr::to_integer<uint8_t>(parts[i], 16) };
-				if (!value.has_value())
-				{
-					return nullptr;
-				}
-				opstrs.push_back(value.value());
-			}
-		}
-
 		script_info newinfo
 		{
 			.name    = std::string{ name },
@@ -234,129 +373,164 @@ namespace mes
 
 		std::memcpy((void*)(&newinfo.uint8x2), values, sizeof(values));
 		
-		bool is_existing{ false };
-		for (auto& info : script_info::script_infos)
-		{
-			if (info.name == name)
-			{
-				info.set(std::move(newinfo));
-				if (info.version == version.value())
-				{
-					return &info;
-				}
-				is_existing = true;
-				break;
-			}
-		}
-
-		if (!is_existing)
+		if (const size_t index{ registry::find(name) }; index != registry::nops)
 		{
-			script_info::script_infos.push_back(script_info{});
-			script_info& back{ script_info::script_infos.back() };
-			back.set(std::move(newinfo));
+			script_info& info{ script_info::script_infos[index] };
+			info.set(std::move(newinfo));
+			registry::rebuild(); // 版本号可能变了，优先级按新的版本号重新登记
+			return &info;
 		}
 
-		std::ranges::sort
-		(
-			script_info::script_infos.begin(),
-			script_info::script_infos.end(),
-			std::greater{},
-			&script_info::version
-		);
+		// 新条目追加到末尾，已有条目的下标不变，只需登记新条目
+		script_info::script_infos.emplace_back().set(std::move(newinfo));
+		const size_t index{ script_info::script_infos.size() - 1 };
+		registry::add(script_info::script_infos[index], index);
 
-		return script_info::query(name);
+		return &script_info::script_infos[index];
 	}
 
-	auto script_info::query(const std::span<uint8_t> data) noexcept -> const script_info*
+	struct header_versions
 	{
-		if (!data.data() || data.empty())
+		uint16_t version1{}, version2{};
+		int32_t  head1{};
+
+		// 读取 offset1 / offset2 两种布局下的版本号
+		static auto read(const std::span<uint8_t> data) noexcept -> header_versions
 		{
-			return nullptr;
-		}
+			header_versions result{};
+			if (!data.data() || data.size() <= 4)
+			{
+				return result;
+			}
 
-		const size_t   size{ data.size() };
-		const int32_t* head{ reinterpret_cast<int32_t*>(data.data()) };
+			const size_t   size{ data.size() };
+			const int32_t* head{ reinterpret_cast<int32_t*>(data.data()) };
 
-		uint16_t version1{}, version2{};
-		if (size > 4)
-		{
 			const int32_t offset1{ head[0] * 0x04 + 0x04 };
 			const int32_t offset2{ head[0] * 0x06 + 0x04 };
 
 			if (size > offset1 + 0x02)
 			{
-				version1 = *reinterpret_cast<uint16_t*>(data.data() + offset1);
+				result.version1 = *reinterpret_cast<uint16_t*>(data.data() + offset1);
 			}
 			if (size > offset2 + 0x02)
 			{
-				version2 = *reinterpret_cast<uint16_t*>(data.data() + offset2);
+				result.version2 = *reinterpret_cast<uint16_t*>(data.data() + offset2);
+				result.head1    = size >= 0x08 ? head[1] : 0x00;
 			}
+			return result;
 		}
 
-		if (version1 == 0x00 && version2 == 0x00)
+		auto empty() const noexcept -> bool
 		{
-			return nullptr;
+			return this->version1 == 0x00 && this->version2 == 0x00;
 		}
 
-		for (const auto& info : script_info::script_infos)
+		auto match(const script_info& info) const noexcept -> bool
 		{
-			switch (info.offset)
+			if (info.offset == script_info::offset1)
 			{
-			case script_info::offset1:
-			{
-				if (version1 == 0x00)
+				if (this->version1 == 0x00)
 				{
-					continue;
+					return false;
 				}
 				if ((info.version & 0xFF00) == 0x00)
 				{
-					if ((version1 & 0xFF) == info.version)
-					{
-						return &info;
-					}
-				}
-				else if (info.version == version1)
-				{
-					return &info;
+					return (this->version1 & 0xFF) == info.version;
 				}
-				continue;
+				return info.version == this->version1;
 			}
-			case script_info::offset2:
+			return this->version2 != 0x00 && this->head1 == 0x03 && info.version == this->version2;
+		}
+	};
+
+	auto script_info::query(const std::span<uint8_t> data) noexcept -> const script_info*
+	{
+		const header_versions header{ header_versions::read(data) };
+		if (header.empty())
+		{
+			return nullptr;
+		}
+
+		const uint16_t version1{ header.version1 }, version2{ header.version2 };
+		size_t index{ registry::nops };
+		if (version1 != 0x00)
+		{
+			index = registry::first(index, registry::find(registry::full1 | version1));
+			index = registry::first(index, registry::find(registry::masked1 | (version1 & 0xFF)));
+		}
+		if (version2 != 0x00 && header.head1 == 0x03)
+		{
+			index = registry::first(index, registry::find(registry::full2 | version2));
+		}
+
+		return index != registry::nops ? &script_info::script_infos[index] : nullptr;
+	}
+
+	auto script_info::candidates(const std::span<uint8_t> data) noexcept -> std::vector<const script_info*>
+	{
+		std::vector<const script_info*> result{};
+		const header_versions header{ header_versions::read(data) };
+		if (!header.empty())
+		{
+			for (const auto& info : script_info::script_infos)
 			{
-				if (version2 == 0x00)
-				{
-					continue;
-				}
-				if (head[1] == 0x03 && info.version == version2)
-				{
-					return &info;
-				}
-				continue;
+				if (header.match(info)) result.push_back(&info);
 			}
-			};
+			// parse 追加的条目不在有序位置上，按与 query 相同的优先级排好（稳定排序保留下标顺序）
+			std::ranges::stable_sort(result, std::greater{}, &script_info::version);
 		}
+		return result;
+	}
 
-		return nullptr;
+	auto script_info::detect(const std::span<uint8_t> data) noexcept -> const script_info*
+	{
+		const std::vector<const script_info*> candidates{ script_info::candidates(data) };
+		return script_info::detect(data, candidates);
 	}
 
-	auto script_info::query(const std::string_view name) noexcept -> const script_info*
+	auto script_info::detect(const std::span<uint8_t> data, const std::span<const script_info* const> candidates) noexcept -> const script_info*
 	{
-		if (!name.empty())
+		if (candidates.size() <= 1)
 		{
-			for (const auto& info : script_info::script_infos)
+			return candidates.empty() ? nullptr : candidates.front();
+		}
+
+		// 每个候选各自试解析 asmbin 的前缀，互不相关，可以并行打分
+		std::vector<int64_t> scores(candidates.size());
+		std::transform
+		(
+			std::execution::par,
+			candidates.begin(), candidates.end(), scores.begin(),
+			[data](const script_info* info) -> int64_t
 			{
-				if (name == info.name) return &info;
+				return script_view::score(data, info);
 			}
+		);
+
+		// 分数相同时保留靠前的候选，与 query 的结果一致
+		size_t best{};
+		for (size_t i{ 1 }; i < scores.size(); i++)
+		{
+			if (scores[i] > scores[best]) best = i;
 		}
-		return nullptr;
+		return candidates[best];
 	}
 
-	auto script_info::query(const uint16_t version) noexcept -> const script_info*
+	auto script_info::query(const std::string_view name) noexcept -> const script_info*
 	{
-		for (const auto& info : script_info::script_infos)
+		if (!name.empty())
 		{
-			if (version == info.version) return &info;
+			const size_t index{ registry::find(name) };
+			if (index != registry::nops) return &script_info::script_infos[index];
 		}
 		return nullptr;
 	}
+
+	auto script_info::query(const uint16_t version) noexcept -> const script_info*
+	{
+		const size_t index{ registry::find(registry::any | version) };
+		if (index != registry::nops) return &script_info::script_infos[index];
+		return nullptr;
+	}
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <algorithm> 
 #include <ranges>
+#include <numeric>
+#include <execution>
+#include <cstring>
 #include <xstr.hpp>
 #include <script_text.hpp>
 
@@ -235,82 +238,466 @@ namespace mes::text
 		text = buffer.wstring();
 	}
 
-	auto parse_format(const xfsys::file& file, std::vector<entry>& output, const text::formater& formater, bool entry_wstring) -> void
+	namespace dump
 	{
-		output.clear();
+		inline constexpr std::u8string_view header { u8"#0x" };
+		inline constexpr std::u8string_view beg_mark{ u8"★◎" };
+		inline constexpr std::u8string_view end_mark{ u8"◎★" };
+		inline constexpr std::u8string_view comment { u8"//" };
+		inline constexpr std::u8string_view header_line{ u8"\n#0x" };
 
-		if (!file.is_open())
+		static inline auto is_space(const char8_t chr) noexcept -> bool
 		{
-			return;
+			return chr == u8' ' || (chr >= u8'\t' && chr <= u8'\r');
 		}
 
-		xstr::buffer<char8_t> buffer{};
-		const auto bytes_read{ file.read(buffer, file.size(), xfsys::file::pos::begin) };
-		
-		if (bytes_read == 0 || buffer.count() == 0)
+		// 各块在工作线程中独立解析，每条记录交给 callback 写入该块自己的 part，调用者再按块的顺序拼接
+		// 块内的记录表放在默认堆上，调用者 output 的 resource 不一定是线程安全的
+		template<class part_t, class callback_t>
+		static auto parse_parallel(const std::u8string_view data, std::vector<part_t>& parts, const callback_t& callback) -> bool
 		{
-			return;
+			const std::vector<std::u8string_view> chunks{ dump_parser{ data }.split() };
+			if (chunks.size() < 2)
+			{
+				return false;
+			}
+
+			parts.resize(chunks.size());
+			std::vector<size_t> indices(chunks.size());
+			std::iota(indices.begin(), indices.end(), size_t{});
+
+			std::for_each(std::execution::par, indices.begin(), indices.end(),
+				[&](const size_t index) -> void
+				{
+					std::pmr::vector<dump_parser::record> records{};
+					dump_parser{ chunks[index] }.parse(records);
+					for (const dump_parser::record& record : records)
+					{
+						callback(parts[index], record);
+					}
+				}
+			);
+			return true;
+		}
+	}
+
+	auto dump_parser::parse_hex(const std::u8string_view str, int32_t& value) noexcept -> bool
+	{
+		uint32_t result{};
+		size_t   index {};
+
+		for (; index < str.size() && index < 8; index++)
+		{
+			const uint8_t chr{ static_cast<uint8_t>(str[index]) };
+			const uint8_t low{ static_cast<uint8_t>(chr | 0x20) };
+
+			if (chr >= '0' && chr <= '9')
+			{
+				result = (result << 4) | static_cast<uint32_t>(chr - '0');
+			}
+			else if (low >= 'a' && low <= 'f')
+			{
+				result = (result << 4) | static_cast<uint32_t>(low - 'a' + 0x0A);
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if (index == 0)
+		{
+			return false;
+		}
+
+		value = static_cast<int32_t>(result);
+		return true;
+	}
+
+	auto dump_parser::parse(std::pmr::vector<record>& output) const noexcept -> size_t
+	{
+		if (this->m_data.empty())
+		{
+			return 0;
+		}
+
+		const size_t original_size{ output.size() };
+		{
+			// 每个条目占 4 行（#0x、原文、译文、空行）
+			const auto lines{ std::ranges::count(this->m_data, u8'\n') };
+			output.reserve(original_size + static_cast<size_t>(lines / 4) + 1);
 		}
 
+		const char8_t* current{ this->m_data.data() };
+		const char8_t* const last{ current + this->m_data.size() };
+
 		int32_t offset{ -1 };
-		for (const std::u8string_view& line : xstr::line::iter(buffer, true))
+		while (current < last)
 		{
+			const auto next{ static_cast<const char8_t*>(std::memchr(current, '\n', static_cast<size_t>(last - current))) };
+
+			const char8_t* beg{ current };
+			const char8_t* end{ next != nullptr ? next : last };
+			current = { next != nullptr ? next + 1 : last };
+
+			while (beg < end && dump::is_space(*beg)) { ++beg; }
+			while (end > beg && dump::is_space(*(end - 1))) { --end; }
+
+			const std::u8string_view line{ beg, static_cast<size_t>(end - beg) };
 			if (line.empty())
 			{
 				continue;
 			}
 
-			if (line.starts_with(u8"#0x"))
+			if (line[0] == u8'#')
 			{
-				const auto data{ reinterpret_cast<const char*>(line.data()) };
-				const int matched{ std::sscanf(data, "#0x%X", &offset) };
-				if (matched != 1)
+				if (!line.starts_with(dump::header) || !dump_parser::parse_hex(line.substr(dump::header.size()), offset))
 				{
 					offset = -1;
 				}
 				continue;
 			}
 
-			if (offset == -1)
+			if (offset == -1 || !line.starts_with(dump::beg_mark))
 			{
 				continue;
 			}
 
-			if (!line.starts_with(u8"★◎")) 
+			const size_t pos{ line.find(dump::end_mark, dump::beg_mark.size()) };
+			if (pos == std::u8string_view::npos)
 			{
 				continue;
 			}
 
-			if (line.find(u8"//", 6) != std::u8string_view::npos)
+			const std::u8string_view text{ line.substr(pos + dump::end_mark.size()) };
+			if (text.starts_with(dump::comment))
 			{
 				continue;
 			}
 
-			const size_t pos{ line.find(u8"◎★", 6) };
-			if (pos == std::u8string_view::npos)
+			output.push_back(record{ .offset = offset, .text = text });
+			offset = -1;
+		}
+
+		return output.size() - original_size;
+	}
+
+	auto dump_parser::split(const size_t chunk_size) const -> std::vector<std::u8string_view>
+	{
+		std::vector<std::u8string_view> chunks{};
+		const std::u8string_view data{ this->m_data };
+		if (data.empty())
+		{
+			return chunks;
+		}
+
+		chunks.reserve(data.size() / std::max(chunk_size, size_t{ 1 }) + 1);
+		for (size_t beg{}; beg < data.size(); )
+		{
+			size_t end{ data.size() };
+			if (chunk_size != 0 && data.size() - beg > chunk_size)
 			{
-				continue;
+				// 块从行首的 #0x 开始：parse 遇到 # 行总会重置 offset，所以不需要上一块的任何状态
+				const size_t found{ xstr::search(data, dump::header_line, beg + chunk_size - 1) };
+				if (found != std::u8string_view::npos)
+				{
+					end = found + 1;
+				}
 			}
+			chunks.push_back(data.substr(beg, end - beg));
+			beg = end;
+		}
+		return chunks;
+	}
+
+	auto parse_format(const xfsys::file& file, std::vector<entry>& output, const text::formater& formater, bool entry_wstring) -> void
+	{
+		output.clear();
+
+		if (!file.is_open())
+		{
+			return;
+		}
+
+		xstr::buffer<char8_t> buffer{};
+		const auto bytes_read{ file.read(buffer, file.size(), xfsys::file::pos::begin) };
+		
+		if (bytes_read == 0 || buffer.count() == 0)
+		{
+			return;
+		}
 
-			const auto _line{ reinterpret_cast<const std::string_view*>(&line) };
+		const auto push = [&formater, entry_wstring](std::vector<entry>& output, const dump_parser::record& record) -> void
+		{
+			const std::string_view line{ reinterpret_cast<const char*>(record.text.data()), record.text.size() };
 			if (entry_wstring)
 			{
-				std::wstring text{ xstr::convert_to_utf16(_line->substr(pos + 6), CP_UTF8) };
+				std::wstring text{ xstr::convert_to_utf16(line, CP_UTF8) };
 				
 				formater.format(text);
-				output.push_back(entry{ offset, text });
+				output.push_back(entry{ record.offset, text });
 			}
 			else 
 			{
-				std::string text{ _line->substr(pos + 6) };
+				std::string text{ line };
 				formater.format(text, CP_UTF8);
-				output.push_back(entry{ offset, text });
+				output.push_back(entry{ record.offset, text });
 			}
+		};
 
-			offset = -1;
+		if (buffer.count() >= dump_parser::parallel_threshold)
+		{
+			std::vector<std::vector<entry>> parts{};
+			if (dump::parse_parallel(buffer.view(), parts, push))
+			{
+				size_t count{};
+				for (const auto& part : parts)
+				{
+					count += part.size();
+				}
+
+				output.reserve(count);
+				for (auto& part : parts)
+				{
+					output.insert(output.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+				}
+				return;
+			}
+		}
+
+		std::pmr::vector<dump_parser::record> records{};
+		if (dump_parser{ buffer.view() }.parse(records) == 0)
+		{
+			return;
+		}
+
+		output.reserve(records.size());
+		for (const auto& record : records)
+		{
+			push(output, record);
+		}
+	}
+
+	auto parse_format(const xfsys::file& file, text::entries& output, const text::formater& formater) -> size_t
+	{
+		output.clear();
+
+		if (!file.is_open() || file.size() == 0)
+		{
+			return 0;
+		}
+
+		// 文件内容与记录表只在解析期间使用，和条目一起从 output 的 resource 分配，调用者可以按文件整体释放
+		std::pmr::memory_resource* const resource{ output.resource() };
+		std::pmr::vector<char8_t> data(file.size(), resource);
+		const size_t bytes_read{ file.read(data.data(), data.size(), xfsys::file::pos::begin) };
+		if (bytes_read == 0)
+		{
+			return 0;
+		}
+
+		const std::u8string_view view{ data.data(), bytes_read };
+		if (bytes_read >= dump_parser::parallel_threshold)
+		{
+			// 每块的条目与格式化用的字符串都属于该块，工作线程之间不共享任何可写的状态
+			struct part
+			{
+				text::entries texts{};
+				std::string text{};
+			};
+
+			std::vector<part> parts{};
+			const auto push = [&formater](part& part, const dump_parser::record& record) -> void
+			{
+				part.text.assign(reinterpret_cast<const char*>(record.text.data()), record.text.size());
+				formater.format(part.text, CP_UTF8);
+				part.texts.push_copy(record.offset, part.text);
+			};
+
+			if (dump::parse_parallel(view, parts, push))
+			{
+				size_t count{}, bytes{};
+				for (const part& part : parts)
+				{
+					count += part.texts.size();
+					for (const auto& [offset, string] : part.texts)
+					{
+						bytes += string.size();
+					}
+				}
+
+				output.reserve(count, bytes);
+				for (const part& part : parts)
+				{
+					for (const auto& [offset, string] : part.texts)
+					{
+						output.push_copy(offset, string);
+					}
+				}
+				return output.size();
+			}
+		}
+
+		std::pmr::vector<dump_parser::record> records{ resource };
+		if (dump_parser{ view }.parse(records) == 0)
+		{
+			return 0;
+		}
+
+		size_t bytes{};
+		for (const auto& record : records)
+		{
+			bytes += record.text.size();
+		}
+		output.reserve(records.size(), bytes);
+
+		std::string text{};
+		for (const auto& [offset, line] : records)
+		{
+			text.assign(reinterpret_cast<const char*>(line.data()), line.size());
+			formater.format(text, CP_UTF8);
+			output.push_copy(offset, text);
+		}
+
+		return output.size();
+	}
+
+	dump_writer::dump_writer(const xfsys::file& file, const int32_t input_code_page) noexcept
+		: m_file{ file }, m_code_page{ input_code_page }
+	{
+		this->m_buffer.resize(dump_writer::buffer_size);
+		this->m_failed = { !this->m_file.is_open() || this->m_file.seek(xfsys::file::pos::begin, 0) == xfsys::file::error() };
+	}
+
+	dump_writer::~dump_writer() noexcept
+	{
+		this->flush();
+	}
+
+	auto dump_writer::flush() noexcept -> bool
+	{
+		if (this->m_count != 0 && !this->m_failed)
+		{
+			const auto bytes_write{ this->m_file.write(this->m_buffer.data(), this->m_count) };
+			this->m_failed = { bytes_write != this->m_count };
+		}
+		this->m_count = 0;
+		return !this->m_failed;
+	}
+
+	auto dump_writer::put(const std::string_view str) noexcept -> void
+	{
+		if (str.size() > this->m_buffer.size() - this->m_count)
+		{
+			this->flush();
+			if (str.size() > this->m_buffer.size())
+			{
+				if (!this->m_failed)
+				{
+					const auto bytes_write{ this->m_file.write(str.data(), str.size()) };
+					this->m_failed = { bytes_write != str.size() };
+				}
+				return;
+			}
+		}
+		std::memcpy(this->m_buffer.data() + this->m_count, str.data(), str.size());
+		this->m_count += str.size();
+	}
+
+	auto dump_writer::put_escaped(std::string_view str) noexcept -> void
+	{
+		while (!str.empty())
+		{
+			const auto found{ static_cast<const char*>(std::memchr(str.data(), '\n', str.size())) };
+			if (found == nullptr)
+			{
+				this->put(str);
+				break;
+			}
+
+			const size_t length{ static_cast<size_t>(found - str.data()) };
+			this->put(str.substr(0, length));
+			this->put("\\n");
+			str.remove_prefix(length + 1);
 		}
 	}
 
+	auto dump_writer::put_hex(uint32_t value) noexcept -> void
+	{
+		constexpr const char digits[]{ "0123456789ABCDEF" };
+
+		char chars[8]{};
+		size_t index{ sizeof(chars) };
+		do
+		{
+			chars[--index] = digits[value & 0x0F];
+			value >>= 4;
+		} while (value != 0);
+
+		this->put({ chars + index, sizeof(chars) - index });
+	}
+
+	auto dump_writer::put_number(size_t value, const size_t width) noexcept -> void
+	{
+		char chars[24]{};
+		size_t index{ sizeof(chars) };
+		do
+		{
+			chars[--index] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value != 0);
+
+		while (index > 0 && sizeof(chars) - index < width)
+		{
+			chars[--index] = '0';
+		}
+
+		this->put({ chars + index, sizeof(chars) - index });
+	}
+
+	auto dump_writer::write(const size_t number, const int32_t offset, const std::string_view text) noexcept -> void
+	{
+		if (text.empty())
+		{
+			return;
+		}
+
+		std::string_view u8text{ text };
+		if (this->m_code_page != CP_UTF8)
+		{
+			this->m_u16text.clear(), this->m_u8text.clear();
+			xstr::convert_to_utf16(text, this->m_u16text, this->m_code_page);
+			if (!this->m_u16text.empty())
+			{
+				xstr::convert_to_utf8(this->m_u16text, this->m_u8text);
+			}
+			if (!this->m_u8text.empty())
+			{
+				u8text = this->m_u8text;
+			}
+		}
+
+		const auto prefix = [this, number]() -> void
+		{
+			this->put(reinterpret_cast<const char*>(u8"★◎  "));
+			this->put_number(number, 3);
+			this->put(reinterpret_cast<const char*>(u8"  ◎★"));
+		};
+
+		this->put("#0x");
+		this->put_hex(static_cast<uint32_t>(offset));
+		this->put("\n");
+
+		prefix();
+		this->put("//");
+		this->put_escaped(u8text);
+		this->put("\n");
+
+		prefix();
+		this->put_escaped(u8text);
+		this->put("\n\n");
+	}
+
 	auto format_dump(const xfsys::file& file, const std::vector<entry>& input, const int32_t input_code_page) -> bool
 	{
 		if (!file.is_open())
@@ -318,31 +705,243 @@ namespace mes::text
 			return false;
 		}
 
-		xstr::string_buffer buffer{}, this_line{};
+		text::dump_writer writer{ file, input_code_page };
 		for (const auto&& [i, line] : std::views::enumerate(input))
 		{
-			std::string* const entry_string{ line.string() };
+			const std::string* const entry_string{ line.string() };
+			if (entry_string != nullptr)
+			{
+				writer.write(static_cast<size_t>(i + 1), line.offset(), *entry_string);
+			}
+		}
+
+		return writer.flush();
+	}
+
+	auto format_dump(const xfsys::file& file, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		if (!file.is_open())
+		{
+			return false;
+		}
 
-			if (entry_string == nullptr || entry_string->empty())
+		size_t number{};
+		text::dump_writer writer{ file, input_code_page };
+		for (const auto& [offset, string] : input)
+		{
+			writer.write(++number, offset, string);
+		}
+
+		return writer.flush();
+	}
+
+	binary_dump::binary_dump(const xfsys::file& file) noexcept
+	{
+		xfsys::mapping mapping{ file };
+		if (!mapping.is_open() || mapping.size() < sizeof(header))
+		{
+			return;
+		}
+
+		const auto head{ reinterpret_cast<const header*>(mapping.data()) };
+		const size_t table_size{ static_cast<size_t>(head->count) * sizeof(record) };
+		const bool is_valid
+		{
+			std::memcmp(head->magic, binary_dump::magic, sizeof(binary_dump::magic)) == 0 &&
+			head->version == binary_dump::version &&
+			mapping.size() - sizeof(header) >= table_size &&
+			mapping.size() - sizeof(header) - table_size == head->pool_size
+		};
+		if (!is_valid)
+		{
+			return;
+		}
+
+		// 每条记录都必须落在字符串池内
+		const auto records{ reinterpret_cast<const record*>(head + 1) };
+		for (uint32_t index{}; index < head->count; index++)
+		{
+			const record& record{ records[index] };
+			if (static_cast<uint64_t>(record.position) + record.length > head->pool_size)
 			{
-				continue;
+				return;
 			}
+		}
+
+		this->m_mapping = std::move(mapping);
+	}
 
-			buffer.write_as_format("#0x%X\n", line.offset());
-			
-			this_line.reset().write(*entry_string).replace("\n", "\\n");
-			
-			this_line.convert_to_utf8(input_code_page);
+	binary_dump::binary_dump(const std::wstring_view path) noexcept
+		: binary_dump{ xfsys::open(path, xfsys::read, false) }
+	{
+	}
+
+	binary_dump::binary_dump(const std::u8string_view path) noexcept
+		: binary_dump{ xfsys::open(path, xfsys::read, false) }
+	{
+	}
 
-			buffer.write_as_format(u8"★◎  %03d  ◎★//%s\n", i + 1, this_line.data());
-			buffer.write_as_format(u8"★◎  %03d  ◎★%s\n\n", i + 1, this_line.data());
+	auto binary_dump::read(text::entries& output) const -> size_t
+	{
+		output.clear();
+		if (!this->is_open())
+		{
+			return 0;
 		}
 
-		const auto bytes_write{ file.write(buffer, buffer.count(), xfsys::file::pos::begin) };
-		const auto result{ bytes_write == buffer.count() };
-		buffer.clear(), this_line.clear();
+		const std::span<const record>  records{ this->records() };
+		const std::span<const uint8_t> pool{ this->pool() };
+		const auto base{ reinterpret_cast<const char*>(pool.data()) };
 
-		return result;
+		output.source(pool).reserve(records.size(), 0);
+		for (const record& record : records)
+		{
+			output.push_view(record.offset, std::string_view{ base + record.position, record.length });
+		}
+		return output.size();
+	}
+
+	auto binary_dump::write(const xfsys::file& file, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::vector<record> records{};
+		std::vector<char> pool{};
+		records.reserve(input.size());
+
+		std::wstring u16text{};
+		std::string  u8text{};
+		for (const auto& [offset, string] : input)
+		{
+			std::string_view text{ string };
+			if (input_code_page != CP_UTF8 && !text.empty())
+			{
+				// 转换失败时整个容器写入失败，不能把原文悄悄写成空串
+				u16text.clear(), u8text.clear();
+				xstr::convert_to_utf16(text, u16text, input_code_page);
+				if (u16text.empty())
+				{
+					return false;
+				}
+				xstr::convert_to_utf8(u16text, u8text);
+				if (u8text.empty())
+				{
+					return false;
+				}
+				text = u8text;
+			}
+
+			records.push_back(record
+			{
+				.offset   = offset,
+				.position = static_cast<uint32_t>(pool.size()),
+				.length   = static_cast<uint32_t>(text.size())
+			});
+			pool.insert(pool.end(), text.begin(), text.end());
+		}
+
+		const header head
+		{
+			.magic     = { binary_dump::magic[0], binary_dump::magic[1], binary_dump::magic[2], binary_dump::magic[3] },
+			.version   = binary_dump::version,
+			.code_page = static_cast<uint32_t>(input_code_page),
+			.count     = static_cast<uint32_t>(records.size()),
+			.pool_size = pool.size()
+		};
+
+		std::vector<uint8_t> buffer(sizeof(header) + records.size() * sizeof(record) + pool.size());
+		std::memcpy(buffer.data(), &head, sizeof(header));
+		std::memcpy(buffer.data() + sizeof(header), records.data(), records.size() * sizeof(record));
+		std::memcpy(buffer.data() + sizeof(header) + records.size() * sizeof(record), pool.data(), pool.size());
+
+		return file.write(buffer, xfsys::file::pos::begin) == buffer.size();
+	}
+
+	auto format_binary(const xfsys::file& file, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		return text::binary_dump::write(file, input, input_code_page);
+	}
+
+	auto string_table::add(const std::string_view text) -> uint32_t
+	{
+		const auto found{ this->m_index.find(text) };
+		if (found != this->m_index.end())
+		{
+			return found->second;
+		}
+
+		const uint32_t id{ static_cast<uint32_t>(this->m_strings.size()) };
+		const auto [it, inserted] { this->m_index.emplace(std::string{ text }, id) };
+		this->m_strings.push_back(&it->first);
+		return id;
+	}
+
+	auto string_table::find(const std::string_view text) const noexcept -> uint32_t
+	{
+		const auto found{ this->m_index.find(text) };
+		return found != this->m_index.end() ? found->second : string_table::nops;
+	}
+
+	string_refs::string_refs(const std::wstring_view path) noexcept
+	{
+		xfsys::mapping mapping{ xfsys::open(path, xfsys::read, false) };
+		if (!mapping.is_open() || mapping.size() < sizeof(header))
+		{
+			return;
+		}
+
+		const auto head{ reinterpret_cast<const header*>(mapping.data()) };
+		const bool is_valid
+		{
+			std::memcmp(head->magic, string_refs::magic, sizeof(string_refs::magic)) == 0 &&
+			head->version  == string_refs::version &&
+			mapping.size() == sizeof(header) + static_cast<size_t>(head->count) * sizeof(record)
+		};
+
+		if (is_valid)
+		{
+			this->m_mapping = std::move(mapping);
+		}
+	}
+
+	auto string_refs::write(const std::wstring_view path, const std::span<const record> records) -> bool
+	{
+		const xfsys::file file{ xfsys::create(path) };
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		const header head
+		{
+			.magic   = { string_refs::magic[0], string_refs::magic[1], string_refs::magic[2], string_refs::magic[3] },
+			.version = string_refs::version,
+			.count   = static_cast<uint32_t>(records.size())
+		};
+
+		std::vector<uint8_t> buffer(sizeof(header) + records.size() * sizeof(record));
+		std::memcpy(buffer.data(), &head, sizeof(header));
+		std::memcpy(buffer.data() + sizeof(header), records.data(), records.size() * sizeof(record));
+		return file.write(buffer, xfsys::file::pos::begin) == buffer.size();
+	}
+
+	auto format_dump(const xfsys::file& file, const text::string_table& input, const int32_t input_code_page) -> bool
+	{
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		text::dump_writer writer{ file, input_code_page };
+		for (const auto&& [id, string] : std::views::enumerate(input.strings()))
+		{
+			writer.write(static_cast<size_t>(id + 1), static_cast<int32_t>(id), *string);
+		}
+
+		return writer.flush();
 	}
 
 	auto parse_format(const xfsys::file& file, const text::formater& formater, bool entry_wstring) -> std::vector<entry>
@@ -372,6 +971,11 @@ namespace mes::text
 		return text::parse_format(xfsys::open(path, xfsys::read, false), formater, entry_wstring);
 	}
 
+	auto parse_format(const std::wstring_view path, text::entries& output, const text::formater& formater) -> size_t
+	{
+		return text::parse_format(xfsys::open(path, xfsys::read, false), output, formater);
+	}
+
 	auto format_dump(const std::u8string_view path, const std::vector<entry>& input, const int32_t input_code_page) -> bool
 	{
 		return text::format_dump(xfsys::create(path), input, input_code_page);
@@ -382,4 +986,29 @@ namespace mes::text
 		return text::format_dump(xfsys::create(path), input, input_code_page);
 	}
 
+	auto format_dump(const std::u8string_view path, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		return text::format_dump(xfsys::create(path), input, input_code_page);
+	}
+
+	auto format_dump(const std::wstring_view path, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		return text::format_dump(xfsys::create(path), input, input_code_page);
+	}
+
+	auto format_dump(const std::wstring_view path, const text::string_table& input, const int32_t input_code_page) -> bool
+	{
+		return text::format_dump(xfsys::create(path), input, input_code_page);
+	}
+
+	auto format_binary(const std::u8string_view path, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		return text::format_binary(xfsys::create(path), input, input_code_page);
+	}
+
+	auto format_binary(const std::wstring_view path, const text::entries& input, const int32_t input_code_page) -> bool
+	{
+		return text::format_binary(xfsys::create(path), input, input_code_page);
+	}
+
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
 #include <tuple>
+#include <span>
 #include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory_resource>
 #include <xstr.hpp>
 #include <xfsys.hpp>
 #include <mes.hpp>
@@ -41,12 +45,82 @@ namespace mes::text
 		variant m_text{};
 	};
 
+	class entries
+	{
+	public:
+
+		enum class storage : uint8_t
+		{
+			arena, // 文本保存在 m_arena 中
+			source // 文本直接指向 m_source（脚本缓冲区）
+		};
+
+		struct handle
+		{
+			int32_t  offset{};
+			uint32_t position{};
+			uint32_t length{};
+			storage  where{};
+		};
+
+		struct value_type
+		{
+			int32_t offset{};
+			std::string_view text{};
+		};
+
+		class iterator
+		{
+			const entries* m_entries{};
+			size_t m_index{};
+
+		public:
+			inline iterator(const entries* entries, size_t index) noexcept : m_entries{ entries }, m_index{ index } {}
+			inline auto operator* () const noexcept -> value_type { return (*this->m_entries)[this->m_index]; }
+			inline auto operator++() noexcept -> iterator& { ++this->m_index; return *this; }
+			inline auto operator==(const iterator& other) const noexcept -> bool { return this->m_index == other.m_index; }
+			inline auto operator!=(const iterator& other) const noexcept -> bool { return this->m_index != other.m_index; }
+		};
+
+		inline entries() noexcept = default;
+		inline explicit entries(std::pmr::memory_resource* resource) noexcept : m_arena{ resource }, m_handles{ resource } {};
+		inline explicit entries(const std::span<const uint8_t> source, 
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept : m_source{ source }, m_arena{ resource }, m_handles{ resource } {};
+
+		inline auto source(const std::span<const uint8_t> source) noexcept -> entries&;
+		inline auto reserve(const size_t count, const size_t bytes) -> void;
+		inline auto clear() noexcept -> void;
+
+		inline auto push_view(const int32_t offset, const std::string_view text) -> void;
+		inline auto push_copy(const int32_t offset, const std::string_view text) -> void;
+		inline auto allocate (const int32_t offset, const size_t length) -> std::span<char>;
+		inline auto shrink_back(const size_t length) noexcept -> void;
+
+		inline auto size () const noexcept -> size_t;
+		inline auto empty() const noexcept -> bool;
+		inline auto handles() const noexcept -> const std::pmr::vector<handle>&;
+		inline auto resource() const noexcept -> std::pmr::memory_resource*;
+		inline auto text (const handle& handle) const noexcept -> std::string_view;
+
+		inline auto begin() const noexcept -> iterator;
+		inline auto end  () const noexcept -> iterator;
+		inline auto operator[](const size_t index) const noexcept -> value_type;
+
+		inline auto to_vector() const -> std::vector<entry>;
+
+	protected:
+		std::span<const uint8_t> m_source {};
+		std::pmr::vector<char>   m_arena  {};
+		std::pmr::vector<handle> m_handles{};
+	};
+
 	class formater 
 	{
 		const mes::config& m_config;
 		mutable bool m_needs_transcoding;
 
-		static inline xstr::buffer<wchar_t> buffer{};
+		// 每个线程各自的格式化缓冲区，并行格式化时互不干扰
+		static inline thread_local xstr::buffer<wchar_t> buffer{};
 
 		static auto is_disallowed_as_start(const wchar_t wchar) -> bool;
 		static auto is_disallowed_as_end  (const wchar_t wchar) -> bool;
@@ -71,10 +145,202 @@ namespace mes::text
 		static auto do_format(xstr::buffer<wchar_t>& buffer, const config& config) -> void;
 	};
 
+	class dump_parser
+	{
+	public:
+
+		struct record
+		{
+			int32_t offset{};
+			std::u8string_view text{};
+		};
+
+		inline static constexpr size_t parallel_threshold{ 0x400000 }; // 文本达到该大小时按 #0x 行分块并行解析、格式化
+		inline static constexpr size_t parallel_chunk    { 0x100000 }; // 并行解析时每块的最小长度
+
+		inline dump_parser(const std::u8string_view data) noexcept : m_data{ data } {};
+
+		auto parse(std::pmr::vector<record>& output) const noexcept -> size_t;
+
+		// 按行首的 #0x 把数据切成不小于 chunk_size 的若干块，每块都从条目的标题行开始，可以各自独立解析
+		auto split(const size_t chunk_size = parallel_chunk) const -> std::vector<std::u8string_view>;
+
+		static auto parse_hex(const std::u8string_view str, int32_t& value) noexcept -> bool;
+
+	protected:
+		const std::u8string_view m_data;
+	};
+
+	class dump_writer
+	{
+	public:
+
+		inline static constexpr size_t buffer_size{ 0x10000 };
+
+		dump_writer(const xfsys::file& file, const int32_t input_code_page) noexcept;
+		~dump_writer() noexcept;
+
+		dump_writer(const dump_writer&) = delete;
+		auto operator=(const dump_writer&) -> dump_writer& = delete;
+
+		auto write(const size_t number, const int32_t offset, const std::string_view text) noexcept -> void;
+		auto flush() noexcept -> bool;
+
+		inline auto failed() const noexcept -> bool;
+
+	protected:
+
+		auto put(const std::string_view str) noexcept -> void;
+		auto put_escaped(const std::string_view str) noexcept -> void;
+		auto put_hex(const uint32_t value) noexcept -> void;
+		auto put_number(const size_t value, const size_t width) noexcept -> void;
+
+		const xfsys::file& m_file;
+		const int32_t m_code_page;
+
+		std::vector<char> m_buffer{};
+		size_t m_count{};
+		bool m_failed{};
+
+		std::wstring m_u16text{};
+		std::string  m_u8text{};
+	};
+
+	// 二进制译文容器，适合由工具生成译文的流程：导入时只需映射文件，条目直接指向字符串池
+	// 文件布局：[header] [record * count] [UTF-8 字符串池]
+	class binary_dump
+	{
+	public:
+
+		#pragma pack(push, 1)
+		struct header
+		{
+			uint8_t  magic[4];
+			uint32_t version;
+			uint32_t code_page; // 导出时脚本文本的代码页，字符串池本身总是 UTF-8
+			uint32_t count;
+			uint64_t pool_size;
+		};
+		#pragma pack(pop)
+
+		#pragma pack(push, 1)
+		struct record
+		{
+			int32_t  offset;
+			uint32_t position; // 在字符串池中的位置
+			uint32_t length;
+		};
+		#pragma pack(pop)
+
+		inline static constexpr uint8_t  magic[4]{ 'M', 'T', 'B', 'D' };
+		inline static constexpr uint32_t version { 0x01 };
+		inline static constexpr std::wstring_view extname{ L".mtb" };
+
+		inline binary_dump() noexcept = default;
+		binary_dump(const xfsys::file& file) noexcept;
+		binary_dump(const std::wstring_view  path) noexcept;
+		binary_dump(const std::u8string_view path) noexcept;
+
+		inline auto is_open  () const noexcept -> bool;
+		inline auto code_page() const noexcept -> uint32_t;
+		inline auto records  () const noexcept -> std::span<const record>;
+		inline auto pool     () const noexcept -> std::span<const uint8_t>;
+
+		// output 中的文本直接引用映射的内存，binary_dump 必须比 output 活得更久
+		auto read(text::entries& output) const -> size_t;
+
+		static auto write(const xfsys::file& file, const text::entries& input, const int32_t input_code_page) -> bool;
+
+	protected:
+		xfsys::mapping m_mapping{};
+	};
+
 	extern auto format_dump(const xfsys::file& file, const std::vector<entry>& input, const int32_t input_code_page) -> bool;
 	extern auto format_dump(const std::u8string_view path, const std::vector<entry>& input, const int32_t input_code_page) -> bool;
 	extern auto format_dump(const std::wstring_view  path, const std::vector<entry>& input, const int32_t input_code_page) -> bool;
 
+	extern auto format_dump(const xfsys::file& file, const text::entries& input, const int32_t input_code_page) -> bool;
+	extern auto format_dump(const std::u8string_view path, const text::entries& input, const int32_t input_code_page) -> bool;
+	extern auto format_dump(const std::wstring_view  path, const text::entries& input, const int32_t input_code_page) -> bool;
+
+	// 跨脚本去重的字符串表：相同的文本只保存一次，按首次出现的顺序编号
+	// 导出为一个 project.txt，条目的偏移字段即编号，因此可以直接用 parse_format 读回
+	class string_table
+	{
+	public:
+
+		inline static constexpr std::wstring_view file_name{ L"project.txt" };
+		inline static constexpr uint32_t nops{ static_cast<uint32_t>(-1) };
+
+		auto add (const std::string_view text) -> uint32_t;
+		auto find(const std::string_view text) const noexcept -> uint32_t;
+
+		inline auto size   () const noexcept -> size_t;
+		inline auto strings() const noexcept -> const std::vector<const std::string*>&;
+
+	protected:
+
+		struct string_hash
+		{
+			using is_transparent = void;
+
+			inline auto operator()(const std::string_view str) const noexcept -> size_t
+			{
+				return std::hash<std::string_view>{}(str);
+			}
+		};
+
+		std::unordered_map<std::string, uint32_t, string_hash, std::equal_to<>> m_index{};
+		std::vector<const std::string*> m_strings{}; // 指向 m_index 的键，节点地址在 rehash 后保持不变
+	};
+
+	// 单个脚本对字符串表的引用：脚本中的偏移 -> 字符串表编号
+	// 文件布局：[header] [record * count]
+	class string_refs
+	{
+	public:
+
+		#pragma pack(push, 1)
+		struct header
+		{
+			uint8_t  magic[4];
+			uint32_t version;
+			uint32_t count;
+		};
+		#pragma pack(pop)
+
+		#pragma pack(push, 1)
+		struct record
+		{
+			int32_t  offset;
+			uint32_t id;
+		};
+		#pragma pack(pop)
+
+		inline static constexpr uint8_t  magic[4]{ 'M', 'T', 'R', 'F' };
+		inline static constexpr uint32_t version { 0x01 };
+		inline static constexpr std::wstring_view extname{ L".ref" };
+
+		inline string_refs() noexcept = default;
+		string_refs(const std::wstring_view path) noexcept;
+
+		inline auto is_open() const noexcept -> bool;
+		inline auto records() const noexcept -> std::span<const record>;
+
+		static auto write(const std::wstring_view path, const std::span<const record> records) -> bool;
+
+	protected:
+		xfsys::mapping m_mapping{};
+	};
+
+	extern auto format_binary(const xfsys::file& file, const text::entries& input, const int32_t input_code_page) -> bool;
+	extern auto format_binary(const std::u8string_view path, const text::entries& input, const int32_t input_code_page) -> bool;
+	extern auto format_binary(const std::wstring_view  path, const text::entries& input, const int32_t input_code_page) -> bool;
+
+	extern auto format_dump(const xfsys::file& file, const text::string_table& input, const int32_t input_code_page) -> bool;
+	extern auto format_dump(const std::wstring_view path, const text::string_table& input, const int32_t input_code_page) -> bool;
+
+	// 文件达到 dump_parser::parallel_threshold 时各块在工作线程中解析、格式化，再按文件中的顺序拼接，结果与逐条处理相同
 	extern auto parse_format(const xfsys::file& file, std::vector<entry>& output, const text::formater& formater, bool entry_wstring = false) -> void;
 	extern auto parse_format(const std::wstring_view  path, std::vector<entry>& output, const text::formater& formater, bool entry_wstring = false) -> void;
 	extern auto parse_format(const std::u8string_view path, std::vector<entry>& output, const text::formater& formater, bool entry_wstring = false) -> void;
@@ -82,8 +348,77 @@ namespace mes::text
 	extern auto parse_format(const xfsys::file& file, const text::formater& formater, bool entry_wstring = false) -> std::vector<entry>;
 	extern auto parse_format(const std::wstring_view  path, const text::formater& formater, bool entry_wstring = false) -> std::vector<entry>;
 	extern auto parse_format(const std::u8string_view path, const text::formater& formater, bool entry_wstring = false) -> std::vector<entry>;
+
+	// 译文统一以窄字符串保存在 output 的 arena 中（格式化后的代码页），临时数据也从 output 的 resource 分配
+	extern auto parse_format(const xfsys::file& file, text::entries& output, const text::formater& formater) -> size_t;
+	extern auto parse_format(const std::wstring_view path, text::entries& output, const text::formater& formater) -> size_t;
 	
 
+	inline auto dump_writer::failed() const noexcept -> bool
+	{
+		return this->m_failed;
+	}
+
+	inline auto binary_dump::is_open() const noexcept -> bool
+	{
+		return this->m_mapping.is_open();
+	}
+
+	inline auto binary_dump::code_page() const noexcept -> uint32_t
+	{
+		if (!this->is_open())
+		{
+			return {};
+		}
+		return reinterpret_cast<const header*>(this->m_mapping.data())->code_page;
+	}
+
+	inline auto binary_dump::records() const noexcept -> std::span<const record>
+	{
+		if (!this->is_open())
+		{
+			return {};
+		}
+		const auto head{ reinterpret_cast<const header*>(this->m_mapping.data()) };
+		return { reinterpret_cast<const record*>(head + 1), head->count };
+	}
+
+	inline auto binary_dump::pool() const noexcept -> std::span<const uint8_t>
+	{
+		if (!this->is_open())
+		{
+			return {};
+		}
+		const auto head{ reinterpret_cast<const header*>(this->m_mapping.data()) };
+		const auto data{ reinterpret_cast<const uint8_t*>(reinterpret_cast<const record*>(head + 1) + head->count) };
+		return { data, static_cast<size_t>(head->pool_size) };
+	}
+
+	inline auto string_table::size() const noexcept -> size_t
+	{
+		return this->m_strings.size();
+	}
+
+	inline auto string_table::strings() const noexcept -> const std::vector<const std::string*>&
+	{
+		return this->m_strings;
+	}
+
+	inline auto string_refs::is_open() const noexcept -> bool
+	{
+		return this->m_mapping.is_open();
+	}
+
+	inline auto string_refs::records() const noexcept -> std::span<const record>
+	{
+		if (!this->is_open())
+		{
+			return {};
+		}
+		const auto head{ reinterpret_cast<const header*>(this->m_mapping.data()) };
+		return { reinterpret_cast<const record*>(head + 1), head->count };
+	}
+
 	inline auto formater::transcoding(const bool needs) noexcept -> void
 	{
 		this->m_needs_transcoding = needs;
@@ -178,4 +513,137 @@ namespace mes::text
 		this->m_text   = std::move(other.m_text);
 		return *this;
 	}
+
+	inline auto entries::source(const std::span<const uint8_t> source) noexcept -> entries&
+	{
+		this->m_source = source;
+		return *this;
+	}
+
+	inline auto entries::reserve(const size_t count, const size_t bytes) -> void
+	{
+		this->m_handles.reserve(count);
+		this->m_arena.reserve(bytes);
+	}
+
+	inline auto entries::clear() noexcept -> void
+	{
+		this->m_source = {};
+		this->m_arena.clear();
+		this->m_handles.clear();
+	}
+
+	inline auto entries::push_view(const int32_t offset, const std::string_view text) -> void
+	{
+		const auto base{ reinterpret_cast<const char*>(this->m_source.data()) };
+		if (text.data() >= base && text.data() + text.size() <= base + this->m_source.size())
+		{
+			this->m_handles.push_back(handle
+			{
+				.offset   = offset,
+				.position = static_cast<uint32_t>(text.data() - base),
+				.length   = static_cast<uint32_t>(text.size()),
+				.where    = storage::source
+			});
+		}
+		else
+		{
+			this->push_copy(offset, text);
+		}
+	}
+
+	inline auto entries::push_copy(const int32_t offset, const std::string_view text) -> void
+	{
+		const std::span<char> buffer{ this->allocate(offset, text.size()) };
+		std::copy(text.begin(), text.end(), buffer.begin());
+	}
+
+	inline auto entries::allocate(const int32_t offset, const size_t length) -> std::span<char>
+	{
+		const size_t position{ this->m_arena.size() };
+		this->m_arena.resize(position + length);
+		this->m_handles.push_back(handle
+		{
+			.offset   = offset,
+			.position = static_cast<uint32_t>(position),
+			.length   = static_cast<uint32_t>(length),
+			.where    = storage::arena
+		});
+		return std::span<char>{ this->m_arena.data() + position, length };
+	}
+
+	inline auto entries::shrink_back(const size_t length) noexcept -> void
+	{
+		if (this->m_handles.empty())
+		{
+			return;
+		}
+
+		handle& back{ this->m_handles.back() };
+		if (length < back.length)
+		{
+			if (back.where == storage::arena)
+			{
+				this->m_arena.resize(back.position + length);
+			}
+			back.length = static_cast<uint32_t>(length);
+		}
+	}
+
+	inline auto entries::size() const noexcept -> size_t
+	{
+		return this->m_handles.size();
+	}
+
+	inline auto entries::empty() const noexcept -> bool
+	{
+		return this->m_handles.empty();
+	}
+
+	inline auto entries::handles() const noexcept -> const std::pmr::vector<handle>&
+	{
+		return this->m_handles;
+	}
+
+	inline auto entries::resource() const noexcept -> std::pmr::memory_resource*
+	{
+		return this->m_handles.get_allocator().resource();
+	}
+
+	inline auto entries::text(const handle& handle) const noexcept -> std::string_view
+	{
+		const char* const base
+		{
+			handle.where == storage::arena ? this->m_arena.data() :
+			reinterpret_cast<const char*>(this->m_source.data())
+		};
+		return std::string_view{ base + handle.position, handle.length };
+	}
+
+	inline auto entries::begin() const noexcept -> iterator
+	{
+		return iterator{ this, 0 };
+	}
+
+	inline auto entries::end() const noexcept -> iterator
+	{
+		return iterator{ this, this->m_handles.size() };
+	}
+
+	inline auto entries::operator[](const size_t index) const noexcept -> value_type
+	{
+		const handle& handle{ this->m_handles[index] };
+		return value_type{ .offset = handle.offset, .text = this->text(handle) };
+	}
+
+	inline auto entries::to_vector() const -> std::vector<entry>
+	{
+		std::vector<entry> result{};
+		result.reserve(this->m_handles.size());
+		for (const auto& [offset, string] : *this)
+		{
+			result.push_back(entry{ offset, string });
+		}
+		return result;
+	}
 }
\ No newline at end of file
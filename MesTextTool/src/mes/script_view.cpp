@@ -1,26 +1,238 @@
 #include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <execution>
+#include <utility>
 #include "mes.hpp"
 
 namespace mes 
 {
+	// 通用版本：按 info 预先算好的表查出操作码的指令类型，适用于任意 info
+	struct table_kind
+	{
+		const script_info* info{};
+
+		inline auto operator()(const uint8_t opcode) const noexcept -> script_info::opcode_kind
+		{
+			return this->info->kind(opcode);
+		}
+	};
 
-	script_view::script_view(const std::span<uint8_t> raw, const script_info* const info)
-		: m_raw{ raw, 0x00 }, m_info{ info }
+	// 指令区间组合，依次为 uint8x2、uint8str、string、encstr、uint16x4 的 [beg, end]，{ 0xFF, 0xFF } 表示不存在
+	struct layout
 	{
-		if (!this->m_raw.data() || raw.empty())
+		uint8_t bounds[10]{};
+
+		inline constexpr auto has(const size_t index) const noexcept -> bool
 		{
-			return;
+			return !(this->bounds[index * 2] == 0xFF && this->bounds[index * 2 + 1] == 0xFF);
 		}
 
-		if (this->m_info == nullptr)
+		inline auto matches(const script_info& info) const noexcept -> bool
 		{
-			this->m_info = script_info::query(raw);
-			if (this->m_info == nullptr)
+			const script_info::section* sections[]{ &info.uint8x2, &info.uint8str, &info.string, &info.encstr, &info.uint16x4 };
+			for (size_t i{}; i < std::size(sections); i++)
 			{
-				return;
+				if (sections[i]->beg != this->bounds[i * 2] || sections[i]->end != this->bounds[i * 2 + 1])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	// 特化版本：区间在编译期确定，判定只剩与常量的比较，不需要经过 info 读表；判定顺序与 make_opcode_kinds 一致
+	template<layout L>
+	struct fixed_kind
+	{
+		template<size_t index>
+		inline static constexpr auto in(const uint8_t opcode) noexcept -> bool
+		{
+			if constexpr (!L.has(index))
+			{
+				return false;
+			}
+			else
+			{
+				return opcode >= L.bounds[index * 2] && opcode <= L.bounds[index * 2 + 1];
+			}
+		}
+
+		inline constexpr auto operator()(const uint8_t opcode) const noexcept -> script_info::opcode_kind
+		{
+			using kind = script_info::opcode_kind;
+			if (fixed_kind::in<0>(opcode)) return kind::uint8x2;
+			if (fixed_kind::in<1>(opcode)) return kind::uint8str;
+			if (fixed_kind::in<2>(opcode)) return kind::string;
+			if (fixed_kind::in<3>(opcode)) return kind::encstr;
+			if (fixed_kind::in<4>(opcode)) return kind::uint16x4;
+			return kind::unknown;
+		}
+	};
+
+	// 内置表中出现过的区间组合，每种组合生成一份特化的解析代码；
+	// 新增内置条目时在这里补上对应的组合，没有列出的组合（包括 parse 读入的自定义 info）使用通用版本
+	inline constexpr layout builtin_layouts[]
+	{
+		{ 0x00, 0x28, 0x29, 0x2E, 0x2F, 0x49, 0x4A, 0x4D, 0x4E, 0xFF }, // ffexa ktlep dcdx dcas dc2fl dc2sc dc2ty dc2pc hmsw shimai renge
+		{ 0x00, 0x28, 0x29, 0x2E, 0x2F, 0x4B, 0x4C, 0x4F, 0x50, 0xFF }, // ffexs
+		{ 0x00, 0x28, 0x2A, 0x2F, 0x30, 0x4A, 0x4B, 0x4E, 0x4F, 0xFF }, // ef
+		{ 0x00, 0x2B, 0xFF, 0xFF, 0x2C, 0x45, 0x46, 0x49, 0x4A, 0xFF }, // dcxx dcws0
+		{ 0x00, 0x2E, 0xFF, 0xFF, 0x2F, 0x49, 0x4A, 0x4D, 0x4E, 0xFF }, // dcmems utaeho5
+		{ 0x00, 0x2B, 0x2C, 0x31, 0x32, 0x4C, 0x4D, 0x50, 0x51, 0xFF }, // dcws dcsv dc2bs dc2cckko dc2ccotm natuiro biscuit alba mtbr
+		{ 0x00, 0x2C, 0xFF, 0xFF, 0x2D, 0x49, 0x4A, 0x4D, 0x4E, 0xFF }, // dcpc
+		{ 0x00, 0x2E, 0xFF, 0xFF, 0x2F, 0x4B, 0x4C, 0x4F, 0x50, 0xFF }, // dcbs dc2fy homemaidt tworld utaeho6
+		{ 0x00, 0x29, 0x2A, 0x31, 0x32, 0x4C, 0x4D, 0x50, 0x51, 0xFF }, // dc2dm
+		{ 0x00, 0x2B, 0x2C, 0x33, 0x34, 0x4E, 0x4F, 0x52, 0x53, 0xFF }, // dc3rx nightshade
+		{ 0x00, 0x2A, 0x2B, 0x32, 0x33, 0x4E, 0x4F, 0x51, 0x52, 0xFF }, // dc3pp
+		{ 0x00, 0x38, 0x39, 0x41, 0x42, 0x5F, 0x60, 0x63, 0x64, 0xFF }, // dc3wy
+		{ 0x00, 0x38, 0x39, 0x43, 0x44, 0x62, 0x63, 0x67, 0x68, 0xFF }, // dc3dd
+		{ 0x00, 0x3A, 0x3B, 0x47, 0x48, 0x68, 0x69, 0x6D, 0x6E, 0xFF }, // dc4 dc4ph
+		{ 0x00, 0x38, 0x39, 0x4A, 0x41, 0x5E, 0x5F, 0x62, 0x63, 0xFF }, // ds
+		{ 0x00, 0x39, 0x3A, 0x42, 0x43, 0x60, 0x61, 0x64, 0x65, 0xFF }, // dsif
+		{ 0x00, 0x3B, 0x3A, 0x46, 0x46, 0x67, 0x68, 0x6E, 0x6D, 0xFF }, // tmpl
+		{ 0x00, 0x28, 0x29, 0x2F, 0x30, 0x4A, 0x4B, 0x4E, 0x4F, 0xFF }, // puripa ccamellia
+		{ 0x00, 0x29, 0x2A, 0x2F, 0x30, 0x4A, 0x4B, 0x4E, 0x4F, 0xFF }, // uni ag2dc diceki arpg0 arpg1
+		{ 0x00, 0x2B, 0xFF, 0xFF, 0x2C, 0x48, 0x49, 0x4C, 0x4D, 0xFF }, // homemaid sukumizu2 suikaas+ sakura sakurasd cdcd cland1
+		{ 0x00, 0x2B, 0xFF, 0xFF, 0x2C, 0x46, 0x47, 0x4A, 0x4B, 0xFF }, // gadejude sukumizu suika
+		{ 0x00, 0x2E, 0x2F, 0x36, 0x37, 0x54, 0x55, 0x57, 0x58, 0xFF }, // suika2
+		{ 0x00, 0x2C, 0xFF, 0xFF, 0x2D, 0x48, 0x49, 0x4C, 0x4D, 0xFF }, // tyakata1 tyakata2 tyakata3 tyakata4
+		{ 0x00, 0x2D, 0xFF, 0xFF, 0x2E, 0x49, 0x4A, 0x4D, 0x4E, 0xFF }, // ariespd ariesld
+		{ 0x00, 0x28, 0x29, 0x2D, 0x2E, 0x48, 0x49, 0x4C, 0x4D, 0xFF }, // mhpc
+		{ 0x00, 0x29, 0x29, 0x2E, 0x2F, 0x49, 0x4A, 0x4D, 0x4E, 0xFF }, // cdcd2
+		{ 0x00, 0x2B, 0x2C, 0x32, 0x33, 0x4D, 0x4E, 0x51, 0x52, 0xFF }, // hrk
+		{ 0x00, 0x28, 0x29, 0x2E, 0x2F, 0x4A, 0x4B, 0x4E, 0x4F, 0xFF }, // tpsk1 tpsk2
+		{ 0x00, 0x39, 0x3A, 0x42, 0x43, 0x62, 0x63, 0x67, 0x68, 0xFF }, // sl
+	};
+
+	template<class callback_t, size_t... indices>
+	static auto with_kind(const script_info& info, callback_t&& callback, std::index_sequence<indices...>) -> void
+	{
+		const bool specialized
+		{
+			(... || (builtin_layouts[indices].matches(info) && (callback(fixed_kind<builtin_layouts[indices]>{}), true)))
+		};
+		if (!specialized)
+		{
+			callback(table_kind{ &info });
+		}
+	}
+
+	// 每个脚本只选择一次：按 info 的区间组合找到特化版本并调用 callback(kind)，找不到时传入通用版本
+	template<class callback_t>
+	static auto with_kind(const script_info& info, callback_t&& callback) -> void
+	{
+		with_kind(info, callback, std::make_index_sequence<std::size(builtin_layouts)>{});
+	}
+
+	// 返回 offset 处指令的长度，无法识别的操作码返回 0；
+	// 字符串最多只找到 asmbin 的末尾，找不到结束符时返回到末尾为止的长度
+	template<class kind_t>
+	static auto token_length(const kind_t& kind, const std::span<uint8_t> asmbin, const size_t offset) noexcept -> int32_t
+	{
+		const uint8_t opcode{ asmbin[offset] };
+		// 返回字符串结束符之后的位置，最多到 asmbin 的末尾
+		const auto string_end = [&asmbin](const size_t start) -> size_t
+		{
+			if (start >= asmbin.size())
+			{
+				return asmbin.size();
+			}
+			const void* end{ std::memchr(asmbin.data() + start, 0x00, asmbin.size() - start) };
+			return end != nullptr ? static_cast<size_t>(static_cast<const uint8_t*>(end) - asmbin.data()) + 1 : asmbin.size();
+		};
+
+		switch (kind(opcode))
+		{
+		case script_info::opcode_kind::uint8x2:
+			return 0x03;
+		case script_info::opcode_kind::uint8str:
+			return static_cast<int32_t>(string_end(offset + 0x02) - offset);
+		case script_info::opcode_kind::string:
+		case script_info::opcode_kind::encstr:
+			return static_cast<int32_t>(string_end(offset) - offset);
+		case script_info::opcode_kind::uint16x4:
+			return 0x09;
+		default:
+			break;
+		}
+		return 0x00;
+	}
+
+	// 文本的可信度：按 ASCII / 半角假名 / 双字节字符（覆盖 Shift-JIS 与 GBK 的编码区间）逐字计分，
+	// 无法解释的字节扣分；encstr 需要先用 key 解密
+	static auto text_score(const uint8_t* str, const size_t size, const uint8_t key) noexcept -> int64_t
+	{
+		int64_t score{};
+		for (size_t i{}; i < size; i++)
+		{
+			const uint8_t chr{ static_cast<uint8_t>(str[i] + key) };
+			if (chr >= 0x81 && chr <= 0xFE && i + 1 < size)
+			{
+				const uint8_t next{ static_cast<uint8_t>(str[i + 1] + key) };
+				if (next >= 0x40 && next <= 0xFE && next != 0x7F)
+				{
+					score += 2;
+					i++;
+					continue;
+				}
+			}
+
+			if ((chr >= 0x20 && chr <= 0x7E) || (chr >= 0xA1 && chr <= 0xDF) || chr == '\n' || chr == '\r' || chr == '\t')
+			{
+				score += 1;
 			}
+			else
+			{
+				score -= 4;
+			}
+		}
+		return score;
+	}
+
+	script_view::script_view(const std::span<uint8_t> raw, const script_info* const info, std::pmr::memory_resource* resource)
+		: m_raw{ raw, 0x00 }, m_info{ info }, m_tokens{ resource }, m_texts{ resource }
+	{
+		if (!this->m_raw.data() || raw.empty() || this->m_info == nullptr)
+		{
+			return;
 		}
 
+		if (!this->init_layout())
+		{
+			return;
+		}
+
+		this->token_parse();
+	}
+
+	auto script_view::detect(const std::span<uint8_t> raw, std::pmr::memory_resource* resource) -> script_view
+	{
+		return script_view{ raw, script_info::detect(raw), resource };
+	}
+
+	script_view::script_view(const std::span<uint8_t> raw, const script_info* const info, const token_cache::entry& cached, std::pmr::memory_resource* resource)
+		: m_raw{ raw, 0x00 }, m_info{ info }, m_tokens{ resource }, m_texts{ resource }
+	{
+		if (!this->m_raw.data() || raw.empty() || this->m_info == nullptr)
+		{
+			return;
+		}
+
+		if (!this->init_layout())
+		{
+			return;
+		}
+
+		if (!this->token_adopt(cached))
+		{
+			this->token_parse();
+		}
+	}
+
+	auto script_view::init_layout() noexcept -> bool
+	{
 		if (this->m_info->offset == script_info::offset1)
 		{
 			this->init_by_offset1();
@@ -31,10 +243,9 @@ namespace mes
 		}
 		else 
 		{
-			return;
+			return false;
 		}
-
-		this->token_parse();
+		return true;
 	}
 
 	auto script_view::init_by_offset1() noexcept -> void
@@ -132,47 +343,402 @@ namespace mes
 			return;
 		}
 
+		with_kind(*this->m_info, [this](const auto& kind) -> void
+		{
+			this->token_parse(kind);
+		});
+	}
+
+	template<class kind_t>
+	auto script_view::token_parse(const kind_t& kind) noexcept -> void
+	{
+		if (this->m_asmbin.size() >= script_view::parallel_threshold && this->token_parse_parallel(kind))
+		{
+			return;
+		}
+
 		for (size_t offset{}; offset < this->m_asmbin.size(); ) 
 		{
 			mes::token token
 			{
 				.data   = &this->m_asmbin[offset],
-				.offset = static_cast<int32_t>(offset)
+				.offset = static_cast<int32_t>(offset),
+				.length = token_length(kind, this->m_asmbin, offset)
 			};
 
-			if (this->m_info->uint8x2.is(token.opcode()))
+			if (token.length == 0x00)
 			{
-				token.length = 0x03;
+				this->m_tokens.clear();
+				return;
 			}
-			else if (this->m_info->uint8str.is(token.opcode()))
+
+			offset += token.length;
+			this->m_tokens.push_back(token);
+		}
+	}
+
+	auto script_view::token_adopt(const token_cache::entry& cached) noexcept -> bool
+	{
+		this->m_tokens.clear();
+		this->m_texts.clear();
+
+		const std::span<const token_cache::record> records{ cached.tokens() };
+		const std::span<const uint32_t> texts{ cached.texts() };
+		if (records.empty())
+		{
+			return false;
+		}
+
+		// find 已经核对过 header 中的脚本哈希、info 指纹与内容的 checksum，缓存内容就是同一脚本完整解析的结果，
+		// 不再逐条校验；这里只确认首尾覆盖整个 asmbin，防止脚本的布局与写缓存时不同
+		const token_cache::record& last{ records.back() };
+		if (records.front().offset != 0 || last.offset < 0 || last.length <= 0 ||
+			static_cast<size_t>(last.offset) >= this->m_asmbin.size() ||
+			static_cast<size_t>(last.offset) + static_cast<size_t>(last.length) < this->m_asmbin.size())
+		{
+			return false;
+		}
+		if (!texts.empty() && texts.back() >= records.size())
+		{
+			return false;
+		}
+
+		this->m_tokens.reserve(records.size());
+		for (const token_cache::record& record : records)
+		{
+			this->m_tokens.push_back
+			(
+				mes::token
+				{
+					.data   = this->m_asmbin.data() + record.offset,
+					.offset = record.offset,
+					.length = record.length
+				}
+			);
+		}
+		this->m_texts.assign(texts.begin(), texts.end());
+		return true;
+	}
+
+	template<class kind_t>
+	auto script_view::token_parse_parallel(const kind_t& kind) noexcept -> bool
+	{
+		const size_t size{ this->m_asmbin.size() };
+
+		// label 指向的位置都是指令边界，可以作为分块的同步点：
+		// labels 位于 0x04 时值为 token 的 offset 加上版本号的字节数，位于 0x08 时低 24 位为指令结束的位置
+		std::vector<size_t> bounds{};
+		bounds.reserve(this->m_labels.size());
+		const int32_t first_token_bytes{ (this->m_info->version & 0xFF00) != 0x00 ? 0x02 : 0x01 };
+		for (const int32_t label : this->m_labels)
+		{
+			const int64_t target
+			{
+				this->m_labels.offset() == 0x04 ?
+				static_cast<int64_t>(label) - first_token_bytes :
+				static_cast<int64_t>(label & 0x00FFFFFF)
+			};
+			if (target > 0 && target < static_cast<int64_t>(size))
 			{
-				token.length  = 0x02;
-				uint8_t* temp = this->m_asmbin.data() + offset + 0x02;
-				do {
-					token.length++;
-					temp++;
-				} while (*(temp - 1));
+				bounds.push_back(static_cast<size_t>(target));
 			}
-			else if (this->m_info->string.is(token.opcode()) || this->m_info->encstr.is(token.opcode()))
+		}
+		std::ranges::sort(bounds);
+
+		// 各块在工作线程中解析，m_tokens 的 resource 不一定是线程安全的，块内的 token 先放在默认堆上
+		struct chunk
+		{
+			size_t beg{}, end{};
+			std::vector<token> tokens{};
+			bool completed{};
+		};
+
+		std::vector<chunk> chunks{ chunk{ .beg = 0 } };
+		for (const size_t bound : bounds)
+		{
+			if (bound - chunks.back().beg >= script_view::parallel_chunk)
 			{
-				uint8_t* temp = this->m_asmbin.data() + offset;
-				do {
-					token.length++;
-					temp++;
-				} while (*(temp - 1));
+				chunks.back().end = bound;
+				chunks.push_back(chunk{ .beg = bound });
 			}
-			else if (this->m_info->uint16x4.is(token.opcode()))
+		}
+		chunks.back().end = size;
+
+		if (chunks.size() < 2)
+		{
+			return false;
+		}
+
+		std::for_each(std::execution::par, chunks.begin(), chunks.end(), [this, size, &kind](chunk& part)
+		{
+			part.tokens.reserve((part.end - part.beg) / 0x08);
+			size_t offset{ part.beg };
+			while (offset < part.end)
 			{
-				token.length = 0x09;
+				const mes::token token
+				{
+					.data   = &this->m_asmbin[offset],
+					.offset = static_cast<int32_t>(offset),
+					.length = token_length(kind, this->m_asmbin, offset)
+				};
+				if (token.length == 0x00)
+				{
+					return;
+				}
+				offset += token.length;
+				part.tokens.push_back(token);
 			}
-			else
+			// 除最后一块外，每块的最后一条指令必须恰好结束在下一块的起点，否则说明同步点不可靠
+			part.completed = part.end == size || offset == part.end;
+		});
+
+		size_t count{};
+		for (const chunk& part : chunks)
+		{
+			if (!part.completed)
 			{
-				this->m_tokens.clear();
-				return;
+				return false;
 			}
+			count += part.tokens.size();
+		}
 
-			offset += token.length;
-			this->m_tokens.push_back(token);
+		this->m_tokens.reserve(count);
+		for (const chunk& part : chunks)
+		{
+			this->m_tokens.insert(this->m_tokens.end(), part.tokens.begin(), part.tokens.end());
+		}
+		return true;
+	}
+
+	auto script_view::score(const std::span<uint8_t> raw, const script_info* const info, const size_t limit) noexcept -> int64_t
+	{
+		// 无法完整解析前缀的候选一律排在能解析的候选之后，彼此之间再按解析到的位置比较
+		constexpr int64_t failed{ -(int64_t{ 1 } << 40) };
+
+		if (info == nullptr || raw.data() == nullptr || raw.size() < 0x08)
+		{
+			return failed;
+		}
+
+		script_view view{};
+		view.m_raw  = view_t<uint8_t>{ raw, 0x00 };
+		view.m_info = info;
+		if (info->offset == script_info::offset1)
+		{
+			view.init_by_offset1();
+		}
+		else
+		{
+			view.init_by_offset2();
+		}
+
+		const view_t<uint8_t>& asmbin{ view.m_asmbin };
+		if (asmbin.empty())
+		{
+			return failed;
+		}
+
+		int64_t score{};
+		with_kind(*info, [&](const auto& kind_of) -> void
+		{
+			const size_t end{ (std::min)(asmbin.size(), limit) };
+			size_t offset{};
+			while (offset < end)
+			{
+				const int32_t length{ token_length(kind_of, asmbin, offset) };
+				if (length == 0x00)
+				{
+					score = failed + static_cast<int64_t>(offset);
+					return;
+				}
+
+				const script_info::opcode_kind kind{ kind_of(asmbin[offset]) };
+				if (offset + length > asmbin.size() || asmbin[offset + length - 1] != 0x00)
+				{
+					if (kind != script_info::opcode_kind::uint8x2 && kind != script_info::opcode_kind::uint16x4)
+					{
+						score = failed + static_cast<int64_t>(offset); // 字符串没有结束符
+						return;
+					}
+				}
+
+				if (kind == script_info::opcode_kind::encstr && length >= 0x02)
+				{
+					score += text_score(asmbin.data() + offset + 1, length - 2, info->enckey);
+				}
+				else if (kind == script_info::opcode_kind::string && length >= 0x02)
+				{
+					score += text_score(asmbin.data() + offset + 1, length - 2, 0x00);
+				}
+				else if (kind == script_info::opcode_kind::uint8str && length >= 0x03)
+				{
+					score += text_score(asmbin.data() + offset + 2, length - 3, 0x00);
+				}
+
+				offset += length;
+			}
+		});
+
+		return score;
+	}
+
+	script_stream::script_stream(const xfsys::file& file, const size_t window, xmem::budget_lease* lease) noexcept
+		: m_file{ file }, m_lease{ lease }
+	{
+		this->m_file_size = { this->m_file.is_open() ? this->m_file.size() : 0 };
+		if (this->m_file_size < 0x08)
+		{
+			this->m_failed = true;
+			return;
+		}
+
+		this->m_buffer.resize((std::min)(this->m_file_size, (std::max)(window, size_t{ 0x08 })), false);
+		if (!this->fill())
+		{
+			return;
+		}
+
+		// advtxt 的开头是文本魔数，不能当作 label 数量扩大窗口，交给调用者整体载入
+		if (mes::advtxt::is_advtxt(std::span{ this->m_buffer.data(), this->m_count }))
+		{
+			return;
+		}
+
+		// 两种布局中 asmbin 最晚从 head[0] * 6 + 7 开始，第一个窗口需要覆盖到识别用的前缀为止
+		const int32_t head{ *reinterpret_cast<const int32_t*>(this->m_buffer.data()) };
+		if (head < 0)
+		{
+			this->m_failed = true;
+			return;
+		}
+
+		const size_t required{ (std::min)(this->m_file_size, static_cast<size_t>(head) * 0x06 + 0x07 + script_view::probe_size) };
+		if (required > this->m_count)
+		{
+			this->grow(required);
+			this->fill();
+		}
+	}
+
+	auto script_stream::grow(const size_t size) noexcept -> void
+	{
+		if (size <= this->m_buffer.size())
+		{
+			return;
+		}
+
+		if (this->m_lease != nullptr)
+		{
+			this->m_lease->grow(size - this->m_buffer.size());
+		}
+		this->m_buffer.resize(size, false);
+	}
+
+	auto script_stream::fill() noexcept -> bool
+	{
+		// 已经处理过的部分不再需要，剩余内容移到缓冲区开头
+		if (this->m_pos != 0)
+		{
+			const size_t remain{ this->m_count - this->m_pos };
+			std::memmove(this->m_buffer.data(), this->m_buffer.data() + this->m_pos, remain);
+			this->m_base += this->m_pos;
+			this->m_count = remain;
+			this->m_pos   = 0;
+		}
+
+		if (this->m_count == this->m_buffer.size())
+		{
+			this->grow(this->m_buffer.size() * 2);
+		}
+
+		const size_t end{ this->m_base + this->m_count };
+		const size_t count{ (std::min)(this->m_buffer.size() - this->m_count, this->m_file_size - end) };
+		const size_t bytes_read{ this->m_file.read(this->m_buffer.data() + this->m_count, count, xfsys::file::pos::begin, end) };
+		if (count == 0 || bytes_read != count)
+		{
+			this->m_failed = true;
+			return false;
+		}
+
+		this->m_count += bytes_read;
+		return true;
+	}
+
+	auto script_stream::release() noexcept -> void
+	{
+		if (this->m_lease != nullptr)
+		{
+			this->m_lease->shrink(this->m_buffer.size());
+		}
+		this->m_buffer = xmem::buffer<uint8_t>{};
+		this->m_count  = this->m_pos = 0;
+		this->m_info   = nullptr;
+		this->m_failed = true;
+	}
+
+	auto script_stream::begin(const script_info* const info) noexcept -> bool
+	{
+		if (this->m_failed || info == nullptr || this->prefix().empty())
+		{
+			return false;
+		}
+
+		script_view view{};
+		view.m_raw  = script_view::view_t<uint8_t>{ this->prefix(), 0x00 };
+		view.m_info = info;
+		if (!view.init_layout() || view.m_asmbin.empty())
+		{
+			return false;
+		}
+
+		this->m_info   = info;
+		this->m_asmbin = view.m_asmbin.offset();
+		this->m_pos    = static_cast<size_t>(this->m_asmbin);
+		return true;
+	}
+
+	auto script_stream::next(mes::token& token) noexcept -> bool
+	{
+		while (this->m_info != nullptr && !this->m_failed && !this->m_finished)
+		{
+			const bool eof{ this->m_base + this->m_count >= this->m_file_size };
+			if (this->m_pos >= this->m_count)
+			{
+				this->m_finished = eof;
+				if (eof || !this->fill())
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const std::span<uint8_t> window{ this->m_buffer.data() + this->m_pos, this->m_count - this->m_pos };
+			const int32_t length{ token_length(table_kind{ this->m_info }, window, 0) };
+			if (length == 0x00)
+			{
+				this->m_failed = true;
+				return false;
+			}
+
+			// 字符串在窗口内没有结束，或者定长指令被窗口截断：读入后面的内容再重新计算
+			if (!eof && static_cast<size_t>(length) >= window.size())
+			{
+				if (!this->fill())
+				{
+					return false;
+				}
+				continue;
+			}
+
+			token = mes::token
+			{
+				.data   = window.data(),
+				.offset = static_cast<int32_t>(this->m_base + this->m_pos - static_cast<size_t>(this->m_asmbin)),
+				.length = length
+			};
+			this->m_pos += (std::min)(static_cast<size_t>(length), window.size());
+			return true;
 		}
+		return false;
 	}
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include <iostream>
 #include <xstr.hpp>
 #include <algorithm>
+#include <execution>
+#include <numeric>
+#include <map>
+#include <unordered_map>
 #include <scripts_handler.hpp>
 
 namespace mes::scripts
@@ -8,12 +12,14 @@ namespace mes::scripts
 	scripts_handler::scripts_handler(std::wstring_view input_directory_or_file, std::wstring_view output_directory) noexcept :
 		m_input_directory_or_file{ xstr::trim(input_directory_or_file) }, m_output_directory{ xstr::trim(output_directory) }
 	{
+		this->m_helper.use_resource(&this->m_resource).use_detector(&this->m_detector);
 	}
 
 	scripts_handler::scripts_handler(std::u8string_view input_directory_or_file, std::u8string_view output_directory) noexcept :
 		m_input_directory_or_file{ xstr::cvt::to_utf16(xstr::trim(input_directory_or_file)) },
 		m_output_directory{ xstr::cvt::to_utf16(xstr::trim(output_directory)) }
 	{
+		this->m_helper.use_resource(&this->m_resource).use_detector(&this->m_detector);
 	}
 
 	auto scripts_handler::export_text(const std::wstring_view file, std::vector<mes::unioninfo>& output_infos) const -> bool
@@ -88,13 +94,16 @@ namespace mes::scripts
 			{
 				name = name.substr(0, dotpos);
 			}
-			output_file_path.assign(xfsys::path::join(output_directory, xstr::join(name, L".txt")));
+			const std::wstring_view extname{ this->m_binary_dump ? mes::text::binary_dump::extname : std::wstring_view{ L".txt" } };
+			output_file_path.assign(xfsys::path::join(output_directory, xstr::join(name, extname)));
 		}
 
-		const std::vector<mes::text::entry> texts{ this->m_helper.export_text() };
+		this->m_helper.export_text(this->m_texts);
 		const bool completed
 		{
-			mes::text::format_dump(output_file_path, texts, this->m_input_mes_code_page)
+			this->m_binary_dump ?
+			mes::text::format_binary(output_file_path, this->m_texts, this->m_input_mes_code_page) :
+			mes::text::format_dump  (output_file_path, this->m_texts, this->m_input_mes_code_page)
 		};
 
 		if (this->m_logger)
@@ -112,9 +121,348 @@ namespace mes::scripts
 		return completed;
 	}
 
+	auto scripts_handler::export_project(const std::vector<std::wstring>& files, std::vector<mes::unioninfo>& output_infos) const -> void
+	{
+		struct exported
+		{
+			mes::unioninfo info{};
+			mes::text::entries texts{};
+		};
+
+		// 各脚本互不相关，先并行解析与导出，条目复制到各自的 arena 中，解析用的缓冲区随线程结束释放
+		std::vector<exported> results(files.size());
+		std::vector<size_t> indices(files.size());
+		std::iota(indices.begin(), indices.end(), size_t{});
+
+		std::for_each(std::execution::par, indices.begin(), indices.end(),
+			[&](const size_t index) -> void
+			{
+				const std::wstring& file{ files[index] };
+				if (!xfsys::extname_check(file, L".mes"))
+				{
+					this->log(message_level::warning, xstr::str{ L"Warning! not a .mes file:\n- ", file, L"\n" });
+					return;
+				}
+
+				// 单个脚本的 token 表与导出的条目都放在任务自己的 arena 中，任务结束时整体释放，线程之间不争用全局堆
+				std::pmr::monotonic_buffer_resource arena{};
+				mes::script_helper helper{ this->m_script_info };
+				helper.use_cache(this->m_cache_directory).use_resource(&arena).use_detector(&this->m_detector);
+				if (!helper.load(file).is_parsed())
+				{
+					this->log(message_level::error, xstr::str{ L"Error! Failed to parse the .mes file:\n- ", file, L"\n" });
+					return;
+				}
+
+				mes::text::entries texts{ &arena };
+				if (!helper.export_text(texts))
+				{
+					return;
+				}
+
+				exported& result{ results[index] };
+				result.info = helper.data_view().info();
+				result.texts.reserve(texts.size(), 0);
+				for (const auto& [offset, text] : texts)
+				{
+					result.texts.push_copy(offset, text);
+				}
+			}
+		);
+
+		// 按文件顺序合并进字符串表，保证编号与输出在多次运行之间一致
+		struct project
+		{
+			mes::text::string_table table{};
+			size_t entries{};
+		};
+		std::map<std::string, project, std::less<>> projects{};
+		std::vector<mes::text::string_refs::record> refs{};
+
+		for (size_t index{}; index < results.size(); index++)
+		{
+			const exported& result{ results[index] };
+			const std::string_view name{ result.info.name() };
+			if (name.empty())
+			{
+				continue;
+			}
+
+			if (!std::any_of(output_infos.begin(), output_infos.end(),
+				[&result](const auto& item) { return item.name() == result.info.name(); }))
+			{
+				output_infos.push_back(result.info);
+			}
+
+			const std::wstring u16name{ xstr::cvt::to_utf16(name, CP_UTF8).append(L"_text") };
+			const std::wstring output_directory{ xfsys::path::join(this->m_output_directory, u16name) };
+			if (!xfsys::create_directory(output_directory, true))
+			{
+				this->log(message_level::error, xstr::str{ L"Error! Failed to create the output directory:\n- ", output_directory, L"\n" });
+				continue;
+			}
+
+			auto found{ projects.find(name) };
+			if (found == projects.end())
+			{
+				found = projects.emplace(std::string{ name }, project{}).first;
+			}
+			project& current{ found->second };
+
+			refs.clear();
+			refs.reserve(result.texts.size());
+			for (const auto& [offset, text] : result.texts)
+			{
+				refs.push_back({ .offset = offset, .id = current.table.add(text) });
+			}
+			current.entries += refs.size();
+
+			const std::wstring refname{ xfsys::extname_change(xfsys::path::name(files[index]), mes::text::string_refs::extname) };
+			const std::wstring output_file_path{ xfsys::path::join(output_directory, refname) };
+			const bool completed{ mes::text::string_refs::write(output_file_path, refs) };
+
+			const xstr::str message
+			{
+				L"Export ", (completed ? L"succeeded" : L"failed (unknown error)"), L":\n",
+				L"- raw: ", files[index], L"\n",
+				L"- out: ", output_file_path, L"\n"
+			};
+			this->log(completed ? message_level::normal : message_level::error, message);
+		}
+
+		for (const auto& [name, current] : projects)
+		{
+			const std::wstring u16name{ xstr::cvt::to_utf16(name, CP_UTF8).append(L"_text") };
+			const std::wstring path{ xfsys::path::join(this->m_output_directory, u16name, mes::text::string_table::file_name) };
+			const bool completed{ mes::text::format_dump(path, current.table, this->m_input_mes_code_page) };
+
+			const xstr::str message
+			{
+				L"Project table ", (completed ? L"created" : L"failed (unknown error)"), L": ",
+				std::to_wstring(current.table.size()), L" unique of ", std::to_wstring(current.entries), L" entries\n- ",
+				path, L"\n"
+			};
+			this->log(completed ? message_level::normal : message_level::error, message);
+		}
+	}
+
+	auto scripts_handler::export_stream(const std::vector<std::wstring>& files, std::vector<mes::unioninfo>& output_infos) const -> void
+	{
+		// 每个任务开始前先从预算中取出读取窗口与写入缓冲区的内存，预算用完时在这里等待其他任务结束；
+		// 已经开始的任务需要扩大窗口时只追加记录而不等待，避免任务之间互相等待
+		xmem::budget budget{ this->m_memory_budget };
+		std::vector<mes::unioninfo> infos(files.size());
+		std::vector<size_t> indices(files.size());
+		std::iota(indices.begin(), indices.end(), size_t{});
+
+		const auto output_path = [this](const std::wstring_view file, const mes::unioninfo& info) -> std::wstring
+		{
+			const std::wstring u16name{ xstr::cvt::to_utf16(info.name(), CP_UTF8).append(L"_text") };
+			const std::wstring output_directory{ xfsys::path::join(this->m_output_directory, u16name) };
+			if (!xfsys::create_directory(output_directory, true))
+			{
+				this->log(message_level::error, xstr::str{ L"Error! Failed to create the output directory:\n- ", output_directory, L"\n" });
+				return {};
+			}
+			return xfsys::path::join(output_directory, xfsys::extname_change(xfsys::path::name(file), L".txt"));
+		};
+
+		const auto exported = [this](const std::wstring_view file, const std::wstring_view output_file_path, const bool completed) -> void
+		{
+			const xstr::str message
+			{
+				L"Export ", (completed ? L"succeeded" : L"failed (unknown error)"), L":\n",
+				L"- raw: ", file, L"\n",
+				L"- out: ", output_file_path, L"\n"
+			};
+			this->log(completed ? message_level::normal : message_level::error, message);
+		};
+
+		std::for_each(std::execution::par, indices.begin(), indices.end(),
+			[&](const size_t index) -> void
+			{
+				const std::wstring& file{ files[index] };
+				if (!xfsys::extname_check(file, L".mes"))
+				{
+					this->log(message_level::warning, xstr::str{ L"Warning! not a .mes file:\n- ", file, L"\n" });
+					return;
+				}
+
+				const xfsys::file input{ xfsys::open(file, xfsys::read, false) };
+				const size_t window{ (std::min)(input.size(), mes::script_stream::default_window) };
+				xmem::budget_lease lease{ &budget, window + mes::text::dump_writer::buffer_size };
+
+				mes::script_stream stream{ input, window, &lease };
+				xmem::budget_resource leased{ &lease };
+				std::pmr::monotonic_buffer_resource arena{ &leased }; // 整体载入时的 token 表与条目都记入预算
+				mes::script_helper helper{ this->m_script_info };
+				helper.use_detector(&this->m_detector);
+				if (!helper.stream_begin(stream, xfsys::path::parent(file)))
+				{
+					if (stream.prefix().empty() || (this->m_script_info.advtxt_info() == nullptr && !mes::advtxt::is_advtxt(stream.prefix())))
+					{
+						this->log(message_level::error, xstr::str{ L"Error! Failed to parse the .mes file:\n- ", file, L"\n" });
+						return;
+					}
+
+					// advtxt 的指令依赖整个文件，仍然整体载入：归还 stream 的窗口与写入缓冲区后按文件大小重新申请，
+					// 预算不足时在这里等待；缓冲区不交给共享池，随任务结束释放，解析出的 token 与条目经由 arena 记入预算
+					stream.release();
+					lease.reset(input.size());
+					helper.use_pool(false).use_resource(&arena);
+					mes::text::entries texts{ &arena };
+					if (!helper.load(input).is_parsed() || !helper.export_text(texts))
+					{
+						this->log(message_level::error, xstr::str{ L"Error! Failed to parse the .mes file:\n- ", file, L"\n" });
+						return;
+					}
+
+					infos[index] = helper.data_view().info();
+					const std::wstring output_file_path{ output_path(file, infos[index]) };
+					if (!output_file_path.empty())
+					{
+						exported(file, output_file_path, mes::text::format_dump(output_file_path, texts, this->m_input_mes_code_page));
+					}
+					return;
+				}
+
+				infos[index] = stream.info();
+				const std::wstring output_file_path{ output_path(file, infos[index]) };
+				if (output_file_path.empty())
+				{
+					return;
+				}
+
+				bool completed{};
+				{
+					const xfsys::file output{ xfsys::create(output_file_path) };
+					mes::text::dump_writer writer{ output, static_cast<int32_t>(this->m_input_mes_code_page) };
+					completed = mes::script_helper::stream_export(stream, writer);
+				}
+
+				if (!completed && !stream.completed())
+				{
+					// 文本在解析的同时已经写出，解析失败时删掉不完整的输出，结果与整体载入时一致
+					xfsys::remove(output_file_path);
+					infos[index] = nullptr;
+					this->log(message_level::error, xstr::str{ L"Error! Failed to parse the .mes file:\n- ", file, L"\n" });
+					return;
+				}
+
+				exported(file, output_file_path, completed);
+			}
+		);
+
+		for (const mes::unioninfo& info : infos)
+		{
+			if (!info.empty() && !std::any_of(output_infos.begin(), output_infos.end(),
+				[&info](const auto& item) { return item.name() == info.name(); }))
+			{
+				output_infos.push_back(info);
+			}
+		}
+
+		const xstr::str message
+		{
+			L"Streaming export: peak ", std::to_wstring(budget.peak() >> 10), L" KiB",
+			L" of ", std::to_wstring(budget.limit() >> 10), L" KiB memory budget\n"
+		};
+		this->log(message_level::normal, message);
+	}
+
+	auto scripts_handler::import_project_handle(const mes::config& config) const -> void
+	{
+		const std::wstring table_path{ xfsys::path::join(this->m_input_directory_or_file, mes::text::string_table::file_name) };
+		const mes::text::formater formater{ config };
+		const std::vector<text::entry> strings{ text::parse_format(table_path, formater, false) };
+		if (strings.empty())
+		{
+			this->log(message_level::error, xstr::str{ L"Error! The project table is empty:\n- ", table_path, L"\n" });
+			return;
+		}
+
+		// project.txt 中条目的偏移字段就是字符串表编号；编号来自手工编辑的文本，按编号查找而不按编号开辟数组
+		std::unordered_map<uint32_t, const std::string*> translations{};
+		translations.reserve(strings.size());
+		for (const text::entry& entry : strings)
+		{
+			const std::string* const text{ entry.string() };
+			if (entry.offset() < 0 || text == nullptr || text->empty())
+			{
+				continue;
+			}
+			translations[static_cast<uint32_t>(entry.offset())] = text;
+		}
+
+		std::vector<std::wstring> refpaths{};
+		for (const auto& entry : xfsys::dir::iter(this->m_input_directory_or_file))
+		{
+			if (entry.is_file() && xfsys::extname_check(entry.name(), mes::text::string_refs::extname))
+			{
+				refpaths.emplace_back(entry.full_path());
+			}
+		}
+
+		// 每个脚本使用独立的 script_helper，同一条译文按引用分发到所有出现的位置
+		std::for_each(std::execution::par, refpaths.begin(), refpaths.end(),
+			[&](const std::wstring& refpath) -> void
+			{
+				const std::wstring mesname{ xfsys::extname_change(xfsys::path::name(refpath), L".mes") };
+				const std::wstring mespath{ xfsys::path::join(config.input_path, mesname) };
+				if (!xfsys::is_file(mespath))
+				{
+					this->log(message_level::warning, xstr::str{ L"Warning! File does not exist:\n- ", mespath, L"\n" });
+					return;
+				}
+
+				std::pmr::monotonic_buffer_resource arena{};
+				const mes::text::string_refs references{ refpath };
+				mes::text::entries texts{ &arena };
+				texts.reserve(references.records().size(), 0);
+				for (const mes::text::string_refs::record& record : references.records())
+				{
+					const auto found{ translations.find(record.id) };
+					if (found != translations.end())
+					{
+						texts.push_copy(record.offset, *found->second);
+					}
+				}
+
+				if (texts.empty())
+				{
+					this->log(message_level::warning, xstr::str{ L"Warning! No translated entries are referenced:\n- ", refpath, L"\n" });
+					return;
+				}
+
+				mes::script_helper helper{ this->m_script_info };
+				helper.use_cache(this->m_cache_directory).use_resource(&arena).use_detector(&this->m_detector);
+				if (!helper.load(mespath).is_parsed())
+				{
+					this->log(message_level::error, xstr::str{ L"Error! Failed to parse the .mes file:\n- ", mespath, L"\n" });
+					return;
+				}
+
+				if (!helper.import_text(texts, config.use_code_page, config.use_code_page, true))
+				{
+					const xstr::str msg
+					{
+						L"Error! Failed to import text entries:\n",
+						L"- ref: ", refpath, L"\n",
+						L"- mes: ", mespath, L"\n"
+					};
+					this->log(message_level::error, msg);
+					return;
+				}
+
+				this->save_imported(helper, refpath, mespath);
+			}
+		);
+	}
+
 	auto scripts_handler::export_text_handle() const -> void
 	{
 		std::wstring_view input_path{};
+		std::vector<std::wstring> files{};
 		std::vector<mes::unioninfo> output_script_infos{};
 
 		if (xfsys::is_directory(this->m_input_directory_or_file))
@@ -127,13 +475,30 @@ namespace mes::scripts
 					continue;
 				}
 				const std::wstring full_path{ entry.full_path() };
-				this->export_text(xstr::trim(full_path), output_script_infos);
+				files.emplace_back(xstr::trim(full_path));
 			}
 		}
 		else if(xfsys::is_file(this->m_input_directory_or_file))
 		{
 			input_path = xfsys::path::parent(this->m_input_directory_or_file);
-			this->export_text(this->m_input_directory_or_file, output_script_infos);
+			files.emplace_back(this->m_input_directory_or_file);
+		}
+
+		if (this->m_project_mode)
+		{
+			this->export_project(files, output_script_infos);
+		}
+		else if (this->m_memory_budget != 0 && !this->m_binary_dump)
+		{
+			// .mtb 的文件头需要预先知道条目数量，仍然整体导出
+			this->export_stream(files, output_script_infos);
+		}
+		else
+		{
+			for (const std::wstring& file : files)
+			{
+				this->export_text(file, output_script_infos);
+			}
 		}
 
 		if (output_script_infos.empty())
@@ -160,6 +525,59 @@ namespace mes::scripts
 		}
 	}
 
+	auto scripts_handler::log(const message_level level, const std::wstring_view message) const -> void
+	{
+		if (this->m_logger)
+		{
+			const std::lock_guard<std::mutex> lock{ this->m_logger_mutex };
+			this->m_logger(level, message);
+		}
+	}
+
+	auto scripts_handler::save_imported(mes::script_helper& helper, const std::wstring_view txtpath, const std::wstring_view mespath) const -> bool
+	{
+		const std::vector<size_t>& unmatched{ helper.unmatched_labels() };
+		if (!unmatched.empty())
+		{
+			const xstr::str msg
+			{
+				L"Warning! ", std::to_wstring(unmatched.size()), 
+				L" label(s) do not point at a token boundary and were left unchanged (first index: ",
+				std::to_wstring(unmatched.front()), L"):\n- ",
+				mespath,
+				L"\n"
+			};
+			this->log(message_level::warning, msg);
+		}
+
+		const std::wstring save_dirs{ xstr::cvt::to_utf16(helper.last_info_name(), CP_UTF8).append(L"_mes")  };
+		const std::wstring save_path{ xfsys::path::join(this->m_output_directory,  save_dirs) };
+		if (!xfsys::create_directory(save_path))
+		{
+			const xstr::str msg
+			{
+				L"Error! Failed to create the save directory:\n- ",
+				save_path,
+				L"\n"
+			};
+			this->log(message_level::error, msg);
+			return false;
+		}
+		
+		const std::wstring target_path{ xfsys::path::join(save_path, xfsys::path::name(mespath)) };
+		const bool completed{ helper.save(target_path) };
+
+		const xstr::str message
+		{
+			L"Import ", (completed ? L"succeeded" : L"failed (unknown error)"), L":\n",
+			L"- txt: ", txtpath, L"\n",
+			L"- raw: ", mespath, L"\n",
+			L"- out: ", target_path, L"\n"
+		};
+		this->log(completed ? message_level::normal : message_level::error, message);
+		return completed;
+	}
+
 	auto scripts_handler::import_text_handle() const -> void
 	{
 		const auto config{ mes::config::read(this->m_input_directory_or_file) };
@@ -193,6 +611,12 @@ namespace mes::scripts
 			return;
 		}
 
+		if (xfsys::is_file(xfsys::path::join(this->m_input_directory_or_file, mes::text::string_table::file_name)))
+		{
+			this->import_project_handle(config.value());
+			return;
+		}
+
 		const mes::text::formater formater{ config.value() };
 		for (const auto& entry : xfsys::dir::iter(this->m_input_directory_or_file))
 		{
@@ -201,11 +625,12 @@ namespace mes::scripts
 				continue;
 			}
 
-			if (!xfsys::extname_check(entry.name(), L".txt"))
+			const bool is_binary{ xfsys::extname_check(entry.name(), mes::text::binary_dump::extname) };
+			if (!is_binary && !xfsys::extname_check(entry.name(), L".txt"))
 			{
 				const xstr::str msg
 				{
-					L"Warning! not a .txt file:\n- ",
+					L"Warning! not a .txt or .mtb file:\n- ",
 					entry.full_path(),
 					L"\n"
 				};
@@ -213,6 +638,24 @@ namespace mes::scripts
 				continue;
 			}
 
+			// 同名的 .txt 与 .mtb 同时存在时总是导入 .mtb，不受目录遍历顺序影响，否则同一脚本会被导入两次
+			if (!is_binary)
+			{
+				const std::wstring mtbpath{ xfsys::extname_change(entry.full_path(), mes::text::binary_dump::extname) };
+				if (xfsys::is_file(mtbpath))
+				{
+					const xstr::str msg
+					{
+						L"Warning! Both .txt and .mtb exist, the .txt is ignored:
+",
+						L"- txt: ", entry.full_path(), L"\n",
+						L"- mtb: ", mtbpath, L"\n"
+					};
+					this->log(message_level::warning, msg);
+					continue;
+				}
+			}
+
 			const std::wstring mesname{ xfsys::extname_change(entry.name(), L".mes")   };
 			const std::wstring mespath{ xfsys::path::join(config->input_path, mesname) };
 			if (!xfsys::is_file(mespath))
@@ -246,70 +689,63 @@ namespace mes::scripts
 			}
 
 			const std::wstring txtpath{ entry.full_path() };
-			const bool entry_wstring{ this->m_helper.data_view().type() == unionmes_view::advtxt_type };
-			const std::vector<text::entry> texts { text::parse_format(txtpath, formater, entry_wstring) };
-
-			if (texts.empty())
-			{
-				const xstr::str msg
-				{
-					L"Warning! The parsed texts are empty:\n- ",
-					txtpath,
-					L"\n"
-				};
-				this->m_logger(message_level::warning, msg);
-				continue;
-			}
-
-			const auto imported{ this->m_helper.import_text(texts, config->use_code_page, true) };
-			if (!imported)
+			bool imported{ false };
+			if (is_binary)
 			{
-				const xstr::str msg
+				// 二进制容器由工具生成，不经过排版，条目直接引用映射的字符串池
+				const mes::text::binary_dump dump{ txtpath };
+				if (dump.read(this->m_texts) == 0)
 				{
-					L"Error! Failed to import text entries:\n",
-					L"- txt: ", txtpath, L"\n",
-					L"- mes: ", mespath, L"\n"
-				};
-				this->m_logger(message_level::error, msg);
-				continue;
+					const xstr::str msg
+					{
+						L"Warning! The binary container is invalid or empty:\n- ",
+						txtpath,
+						L"\n"
+					};
+					this->m_logger(message_level::warning, msg);
+					continue;
+				}
+				imported = this->m_helper.import_text(this->m_texts, CP_UTF8, config->use_code_page, true);
+				this->m_texts.clear();
 			}
-
-			const std::wstring save_dirs{ xstr::cvt::to_utf16(this->m_helper.last_info_name(), CP_UTF8).append(L"_mes")  };
-			const std::wstring save_path{ xfsys::path::join(this->m_output_directory,  save_dirs) };
-			if (!xfsys::create_directory(save_path))
+			else
 			{
-				if (this->m_logger)
+				if (text::parse_format(txtpath, this->m_texts, formater) == 0)
 				{
 					const xstr::str msg
 					{
-						L"Error! Failed to create the save directory:\n- ",
-						save_path,
+						L"Warning! The parsed texts are empty:\n- ",
+						txtpath,
 						L"\n"
 					};
-					this->m_logger(message_level::error, msg);
+					this->m_logger(message_level::warning, msg);
+					continue;
 				}
-				continue;
+
+				// 格式化后的译文已经是 use_code_page，导入时不需要再转换
+				imported = this->m_helper.import_text(this->m_texts, config->use_code_page, config->use_code_page, true);
+				this->m_texts.clear();
 			}
-			
-			const std::wstring target_path{ xfsys::path::join(save_path, mesname) };
-			const bool completed{ this->m_helper.save(target_path) };
 
-			if (this->m_logger)
+			if (!imported)
 			{
-				const xstr::str message
+				const xstr::str msg
 				{
-					L"Import ", (completed ? L"succeeded" : L"failed (unknown error)"), L":\n",
+					L"Error! Failed to import text entries:\n",
 					L"- txt: ", txtpath, L"\n",
-					L"- raw: ", mespath, L"\n",
-					L"- out: ", target_path, L"\n"
+					L"- mes: ", mespath, L"\n"
 				};
-				this->m_logger(completed ? message_level::normal : message_level::error, message);
+				this->m_logger(message_level::error, msg);
+				continue;
 			}
+
+			this->save_imported(this->m_helper, txtpath, mespath);
 		}
 	}
 
 	auto scripts_handler::set_script_info(const mes::unioninfo info) noexcept -> scripts_handler&
 	{
+		this->m_script_info = info;
 		this->m_helper.using_script_info(info);
 		return *this;
 	}
@@ -320,6 +756,31 @@ namespace mes::scripts
 		return *this;
 	}
 
+	auto scripts_handler::set_cache_directory(const std::wstring_view directory) noexcept -> scripts_handler&
+	{
+		this->m_cache_directory = directory;
+		this->m_helper.use_cache(directory);
+		return *this;
+	}
+
+	auto scripts_handler::set_binary_dump(const bool enable) noexcept -> scripts_handler&
+	{
+		this->m_binary_dump = enable;
+		return *this;
+	}
+
+	auto scripts_handler::set_project_mode(const bool enable) noexcept -> scripts_handler&
+	{
+		this->m_project_mode = enable;
+		return *this;
+	}
+
+	auto scripts_handler::set_memory_budget(const size_t bytes) noexcept -> scripts_handler&
+	{
+		this->m_memory_budget = bytes;
+		return *this;
+	}
+
 	auto scripts_handler::process() const -> time_t
 	{
 		const auto beg{ std::chrono::high_resolution_clock::now() };
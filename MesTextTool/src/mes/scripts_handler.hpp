@@ -1,6 +1,8 @@
 #pragma once
 #include <functional>
 #include <vector>
+#include <mutex>
+#include <memory_resource>
 #include <chrono>
 #include <mes.hpp>
 #include <config.hpp>
@@ -13,11 +15,20 @@ namespace mes::scripts
 
 	class scripts_handler 
 	{
+		// 逐个处理文件时的 token 表与条目都从这里分配，释放的内存留在池中给下一个文件使用
+		mutable std::pmr::unsynchronized_pool_resource m_resource{};
+		mutable mes::script_detector m_detector{}; // 所有线程的 script_helper 共用，同一目录只需识别几次
 		mutable mes::script_helper m_helper{};
+		mutable mes::text::entries m_texts { &m_resource };
 		
 		std::wstring m_input_directory_or_file{};
 		std::wstring m_output_directory{};
 		uint32_t m_input_mes_code_page{ defualt_code_page };
+		bool m_binary_dump{ false }; // 导出为 .mtb 二进制容器而不是 .txt
+		bool m_project_mode{ false }; // 导出为去重后的 project.txt 与每个脚本的 .ref 引用
+		size_t m_memory_budget{ 0 }; // 不为 0 时流式导出，所有线程同时占用的读取窗口与写入缓冲区不超过该值
+		mes::unioninfo m_script_info{};
+		std::wstring m_cache_directory{};
 
 		auto import_text_handle() const -> void;
 
@@ -25,6 +36,12 @@ namespace mes::scripts
 
 		auto export_text(const std::wstring_view path, std::vector<mes::unioninfo>& output_infos) const -> bool;
 
+		auto export_project(const std::vector<std::wstring>& files, std::vector<mes::unioninfo>& output_infos) const -> void;
+
+		auto export_stream(const std::vector<std::wstring>& files, std::vector<mes::unioninfo>& output_infos) const -> void;
+
+		auto import_project_handle(const mes::config& config) const -> void;
+
 		public:
 
 		enum message_level { normal, warning, error };
@@ -39,13 +56,26 @@ namespace mes::scripts
 
 		auto set_mes_code_page(const uint32_t code_page) noexcept -> scripts_handler&;
 
+		auto set_cache_directory(const std::wstring_view directory) noexcept -> scripts_handler&;
+
+		auto set_binary_dump(const bool enable) noexcept -> scripts_handler&;
+
+		auto set_project_mode(const bool enable) noexcept -> scripts_handler&;
+
+		auto set_memory_budget(const size_t bytes) noexcept -> scripts_handler&; // 0 表示整体载入每个脚本
+
 		auto process() const -> time_t;
 
 		auto process(logger_t logger) const -> time_t;
 
 	protected:
 
+		// 并行处理时多个线程会同时输出日志
+		auto log(const message_level level, const std::wstring_view message) const -> void;
+		auto save_imported(mes::script_helper& helper, const std::wstring_view txtpath, const std::wstring_view mespath) const -> bool;
+
 		mutable logger_t m_logger{};
+		mutable std::mutex m_logger_mutex{};
 	};
 
 	using handler = scripts_handler;
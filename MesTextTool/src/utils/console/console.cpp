@@ -13,6 +13,8 @@ namespace console
 
 	console_helper::~console_helper() noexcept
 	{
+		this->m_Batch.detach(); // 在释放控制台之前写出剩余内容并恢复控制台模式
+
 		if (this->m_Window != nullptr)
 		{
 			static_cast<void>(::DestroyWindow(this->m_Window));
@@ -31,6 +33,7 @@ namespace console
 		this->m_Output = ::GetStdHandle(STD_OUTPUT_HANDLE);
 		this->m_Input  = ::GetStdHandle(STD_INPUT_HANDLE);
 		this->m_Window = ::GetConsoleWindow();
+		this->m_Batch.attach(this->m_Output);
 	}
 
 	console::console_helper::console_helper(cdpg_t cdpg) noexcept : console_helper()
@@ -75,6 +78,7 @@ namespace console
 	{
 		if (attrs != attrs::unset)
 		{
+			this->m_Batch.flush();
 			::SetConsoleTextAttribute(this->m_Output, attrs.value);
 		}
 
@@ -101,6 +105,8 @@ namespace console
 
 	auto console_helper::clear() const noexcept -> const console_helper&
 	{
+		this->m_Batch.flush();
+
 		DWORD cellsWritten{};
 		CONSOLE_SCREEN_BUFFER_INFO csbi{};
 		::GetConsoleScreenBufferInfo(this->m_Output, &csbi);
@@ -114,6 +120,8 @@ namespace console
 
 	auto console_helper::read_anykey() const noexcept -> const console_helper&
 	{
+		this->m_Batch.flush();
+
 		INPUT_RECORD inputRecord{};
 		DWORD numRead{};
 		do {
@@ -122,10 +130,22 @@ namespace console
 		return { *this };
 	}
 
+	auto console_helper::batch() const noexcept -> console_batch&
+	{
+		return this->m_Batch;
+	}
+
+	auto console_helper::flush() const noexcept -> const console_helper&
+	{
+		this->m_Batch.flush();
+		return { *this };
+	}
+
 	auto console_helper::write(std::wstring_view content) const noexcept -> const console_helper&
 	{
 		if (this->m_Output != nullptr && !content.empty())
 		{
+			this->m_Batch.flush();
 			::WriteConsoleW(this->m_Output, content.data(), content.size(), NULL, NULL);
 		}
 		return { *this };
@@ -135,6 +155,7 @@ namespace console
 	{
 		if (this->m_Output != nullptr && !content.empty())
 		{
+			this->m_Batch.flush();
 			::WriteConsoleA(this->m_Output, content.data(), content.size(), NULL, NULL);
 		}
 		return { *this };
@@ -388,4 +409,324 @@ namespace console
 		}
 	}
 	
-}
\ No newline at end of file
+
+	console_batch::~console_batch() noexcept
+	{
+		if (this->m_Timer.joinable())
+		{
+			this->m_Timer.request_stop();
+			this->m_Timer.join();
+		}
+		this->detach();
+	}
+
+	auto console_batch::attach(HANDLE output, mode use_mode) noexcept -> console_batch&
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->flush_locked();
+		this->restore_mode();
+
+		DWORD console_mode{};
+		this->m_Output    = output;
+		this->m_IsConsole = output != nullptr && ::GetConsoleMode(output, &console_mode);
+
+		// 控制台需要开启虚拟终端序列才能解析转义序列，开启失败时只能逐段设置颜色
+		const bool needs_virtual_terminal
+		{
+			this->m_IsConsole && (use_mode == mode::automatic || use_mode == mode::ansi) &&
+			(console_mode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) == 0
+		};
+		const bool virtual_terminal
+		{
+			this->m_IsConsole && (use_mode == mode::automatic || use_mode == mode::ansi) &&
+			(!needs_virtual_terminal || ::SetConsoleMode(output, console_mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING))
+		};
+		if (needs_virtual_terminal && virtual_terminal)
+		{
+			this->m_ConsoleMode = console_mode;
+			this->m_RestoreMode = true;
+		}
+
+		if (use_mode == mode::automatic)
+		{
+			use_mode = { !this->m_IsConsole ? mode::plain : virtual_terminal ? mode::ansi : mode::win32 };
+		}
+		this->m_Mode = use_mode;
+		this->m_LastFlush = std::chrono::steady_clock::now();
+		return { *this };
+	}
+
+	auto console_batch::detach() noexcept -> console_batch&
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->flush_locked();
+		this->restore_mode();
+		this->m_Output    = nullptr;
+		this->m_IsConsole = false;
+		return { *this };
+	}
+
+	auto console_batch::restore_mode() noexcept -> void
+	{
+		if (this->m_RestoreMode && this->m_Output != nullptr)
+		{
+			static_cast<void>(::SetConsoleMode(this->m_Output, this->m_ConsoleMode));
+		}
+		this->m_RestoreMode = false;
+	}
+
+	auto console_batch::output_mode() const noexcept -> mode
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		return this->m_Mode;
+	}
+
+	auto console_batch::write(std::wstring_view content, attrs_t attrs) noexcept -> console_batch&
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->append(content, attrs);
+		this->flush_if_needed();
+		return { *this };
+	}
+
+	auto console_batch::write(std::u8string_view content, attrs_t attrs) noexcept -> console_batch&
+	{
+		if (content.empty())
+		{
+			return { *this };
+		}
+
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->append(content, attrs);
+		this->flush_if_needed();
+		return { *this };
+	}
+
+	auto console_batch::writeline(std::wstring_view content, attrs_t attrs) noexcept -> console_batch&
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->append(content, attrs);
+		this->append(L"\n", attrs);
+		this->flush_if_needed();
+		return { *this };
+	}
+
+	auto console_batch::writeline(std::u8string_view content, attrs_t attrs) noexcept -> console_batch&
+	{
+		// 内容与换行在同一次加锁中追加，其他线程的输出不会插在两者之间
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->append(content, attrs);
+		this->append(std::wstring_view{ L"\n" }, attrs);
+		this->flush_if_needed();
+		return { *this };
+	}
+
+	auto console_batch::flush() noexcept -> console_batch&
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->flush_locked();
+		return { *this };
+	}
+
+	auto console_batch::append(std::wstring_view content, attrs_t attrs) noexcept -> void
+	{
+		if (!content.empty())
+		{
+			this->m_Text.append(content);
+			this->commit(attrs);
+		}
+	}
+
+	auto console_batch::append(std::u8string_view content, attrs_t attrs) noexcept -> void
+	{
+		if (content.empty())
+		{
+			return;
+		}
+
+		const auto source{ reinterpret_cast<const char*>(content.data()) };
+		const int  length{ ::MultiByteToWideChar(CP_UTF8, 0, source, static_cast<int>(content.size()), nullptr, 0) };
+		if (length > 0)
+		{
+			// 直接转换到 m_Text 的末尾，不经过临时字符串
+			const size_t position{ this->m_Text.size() };
+			this->m_Text.resize(position + static_cast<size_t>(length));
+			::MultiByteToWideChar(CP_UTF8, 0, source, static_cast<int>(content.size()), this->m_Text.data() + position, length);
+			this->commit(attrs);
+		}
+	}
+
+	auto console_batch::commit(attrs_t attrs) noexcept -> void
+	{
+		if (attrs == attrs::unset)
+		{
+			attrs = attrs::text_default;
+		}
+
+		// 与上一段颜色相同时合并，写出时每段只需要设置一次颜色
+		if (!this->m_Spans.empty() && this->m_Spans.back().attrs == attrs)
+		{
+			this->m_Spans.back().end = this->m_Text.size();
+		}
+		else
+		{
+			this->m_Spans.push_back(span{ .end = this->m_Text.size(), .attrs = attrs });
+		}
+	}
+
+	auto console_batch::flush_if_needed() noexcept -> void
+	{
+		if (this->m_Text.size() >= console_batch::flush_size ||
+			std::chrono::steady_clock::now() - this->m_LastFlush >= console_batch::flush_interval)
+		{
+			this->flush_locked();
+			return;
+		}
+
+		// 文本留在缓冲区中：交给计时线程在间隔到达后写出
+		if (!this->m_Timer.joinable())
+		{
+			try
+			{
+				this->m_Timer = std::jthread{ [this](std::stop_token stop) { this->flush_timer(stop); } };
+			}
+			catch (...)
+			{
+				return; // 无法创建线程时退回到只在写入时检查间隔
+			}
+		}
+		this->m_Pending.notify_one();
+	}
+
+	auto console_batch::flush_timer(std::stop_token stop) noexcept -> void
+	{
+		std::unique_lock<std::mutex> lock{ this->m_Mutex };
+		while (!stop.stop_requested())
+		{
+			if (this->m_Text.empty())
+			{
+				this->m_Pending.wait(lock, stop, [this]() -> bool { return !this->m_Text.empty(); });
+				continue;
+			}
+
+			// 等待期间可能已经被写入线程写出，醒来后按 m_LastFlush 重新判断
+			const auto deadline{ this->m_LastFlush + console_batch::flush_interval };
+			this->m_Pending.wait_until(lock, stop, deadline, []() -> bool { return false; });
+			if (!this->m_Text.empty() && std::chrono::steady_clock::now() >= this->m_LastFlush + console_batch::flush_interval)
+			{
+				this->flush_locked();
+			}
+		}
+	}
+
+	auto console_batch::flush_locked() noexcept -> void
+	{
+		if (!this->m_Text.empty() && this->m_Output != nullptr)
+		{
+			if (this->m_Mode == mode::win32)
+			{
+				this->flush_win32();
+			}
+			else
+			{
+				this->flush_ansi();
+			}
+		}
+
+		this->m_Text.clear();
+		this->m_Spans.clear();
+		this->m_LastFlush = std::chrono::steady_clock::now();
+	}
+
+	auto console_batch::flush_win32() noexcept -> void
+	{
+		size_t begin{};
+		for (const span& span : this->m_Spans)
+		{
+			::SetConsoleTextAttribute(this->m_Output, span.attrs.value);
+			::WriteConsoleW(this->m_Output, this->m_Text.data() + begin, static_cast<DWORD>(span.end - begin), NULL, NULL);
+			begin = span.end;
+		}
+
+		if (this->m_Spans.back().attrs != attrs::text_default)
+		{
+			::SetConsoleTextAttribute(this->m_Output, attrs::text_default);
+		}
+	}
+
+	auto console_batch::flush_ansi() noexcept -> void
+	{
+		// plain 模式直接写出文本，不插入转义序列
+		std::wstring& output{ this->m_Mode == mode::plain ? this->m_Text : this->m_Sequence };
+		if (this->m_Mode != mode::plain)
+		{
+			output.clear();
+			output.reserve(this->m_Text.size() + this->m_Spans.size() * 0x10);
+
+			size_t  begin{};
+			attrs_t current{ attrs::text_default };
+			for (const span& span : this->m_Spans)
+			{
+				if (span.attrs != current)
+				{
+					console_batch::ansi_sequence(span.attrs, output);
+					current = span.attrs;
+				}
+				output.append(this->m_Text, begin, span.end - begin);
+				begin = span.end;
+			}
+
+			if (current != attrs::text_default)
+			{
+				console_batch::ansi_sequence(attrs::text_default, output);
+			}
+		}
+
+		if (this->m_IsConsole)
+		{
+			::WriteConsoleW(this->m_Output, output.data(), static_cast<DWORD>(output.size()), NULL, NULL);
+			return;
+		}
+
+		const int length{ ::WideCharToMultiByte(CP_UTF8, 0, output.data(), static_cast<int>(output.size()), nullptr, 0, nullptr, nullptr) };
+		if (length > 0)
+		{
+			this->m_Bytes.resize(static_cast<size_t>(length));
+			::WideCharToMultiByte(CP_UTF8, 0, output.data(), static_cast<int>(output.size()), this->m_Bytes.data(), length, nullptr, nullptr);
+
+			DWORD written{};
+			::WriteFile(this->m_Output, this->m_Bytes.data(), static_cast<DWORD>(length), &written, nullptr);
+		}
+	}
+
+	auto console_batch::ansi_sequence(attrs_t attrs, std::wstring& output) noexcept -> void
+	{
+		if (attrs == attrs::text_default)
+		{
+			output.append(L"\x1b[0m");
+			return;
+		}
+
+		// Win32 的颜色位依次为蓝、绿、红，ANSI 的颜色编号依次为红、绿、蓝
+		constexpr uint8_t colors[8]{ 0, 4, 2, 6, 1, 5, 3, 7 };
+		const uint16_t value{ attrs.value };
+
+		output.append(L"\x1b[0;");
+		output.append(std::to_wstring((value & 0x08 ? 90 : 30) + colors[value & 0x07]));
+		if ((value & 0xF0) != 0)
+		{
+			output.push_back(L';');
+			output.append(std::to_wstring((value & 0x80 ? 100 : 40) + colors[(value >> 4) & 0x07]));
+		}
+		if ((value & attrs::underscore) != 0)
+		{
+			output.append(L";4");
+		}
+		if ((value & attrs::reverse_video) != 0)
+		{
+			output.append(L";7");
+		}
+		output.push_back(L'm');
+	}
+	
+}
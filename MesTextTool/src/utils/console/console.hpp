@@ -3,6 +3,13 @@
 #include <windows.h>
 #include <type_traits>
 #include <streambuf>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <stop_token>
+#include <condition_variable>
 #include <array>
 
 namespace console 
@@ -171,6 +178,7 @@ namespace console
 	using cdpg_t  = cdpg;
 	using attrs_t = attrs;
 
+	class console_batch;
 	class console_writer;
 	class console_helper;
 	class console_ostream;
@@ -180,6 +188,84 @@ namespace console
 	using ostream_t   = console_ostream;
 	using streambuf_t = console_streambuf;
 	using writer_t    = console_writer;
+	using batch_t     = console_batch;
+
+	// 批量输出：文本与颜色区间先累积在缓冲区中，累积的字符数或距上次写出的时间达到阈值时才写出，析构时写出剩余部分；
+	// 有文本等待写出时由一个计时线程在间隔到达后写出，即使之后长时间没有新的输出也不会滞留
+	// win32 模式只在相邻区间颜色不同时调用 SetConsoleTextAttribute；ansi 模式把颜色转换为转义序列，整批只写一次；
+	// plain 模式不带颜色。输出不是 Win32 控制台时（重定向、管道、Wine 下的 Linux 终端）按 UTF-8 写出
+	class console_batch
+	{
+	public:
+
+		enum class mode : uint8_t
+		{
+			automatic, // 控制台支持虚拟终端序列时用 ansi，不支持时用 win32，输出不是控制台时用 plain
+			win32,
+			ansi,
+			plain // 只输出文本，重定向到文件或管道时不混入转义序列
+		};
+
+		inline static constexpr size_t flush_size{ 0x4000 }; // 累积的字符数达到该值时写出
+		inline static constexpr std::chrono::milliseconds flush_interval{ 100 }; // 距上次写出超过该时间时写出
+
+		inline console_batch() noexcept = default;
+		~console_batch() noexcept;
+
+		console_batch(const console_batch&) = delete;
+		auto operator=(const console_batch&) -> console_batch& = delete;
+
+		// 为了使用 ansi 模式而修改过控制台模式时，detach、再次 attach 或析构时恢复原来的模式
+		auto attach(HANDLE output, mode use_mode = mode::automatic) noexcept -> console_batch&;
+		auto detach() noexcept -> console_batch&; // 写出剩余内容并脱离输出句柄
+
+		// attrs 为 attrs::unset 时按默认颜色输出
+		auto write(std::wstring_view  content, attrs_t attrs = attrs::unset) noexcept -> console_batch&;
+		auto write(std::u8string_view content, attrs_t attrs = attrs::unset) noexcept -> console_batch&;
+
+		auto writeline(std::wstring_view  content, attrs_t attrs = attrs::unset) noexcept -> console_batch&;
+		auto writeline(std::u8string_view content, attrs_t attrs = attrs::unset) noexcept -> console_batch&;
+
+		auto flush() noexcept -> console_batch&;
+
+		auto output_mode() const noexcept -> mode;
+
+	protected:
+
+		struct span
+		{
+			size_t  end{};
+			attrs_t attrs{};
+		};
+
+		auto append(std::wstring_view content, attrs_t attrs) noexcept -> void;
+		auto append(std::u8string_view content, attrs_t attrs) noexcept -> void;
+		auto restore_mode() noexcept -> void;
+		auto commit(attrs_t attrs) noexcept -> void;
+		auto flush_if_needed() noexcept -> void;
+		auto flush_locked() noexcept -> void;
+		auto flush_win32() noexcept -> void;
+		auto flush_ansi() noexcept -> void;
+		auto flush_timer(std::stop_token stop) noexcept -> void;
+
+		static auto ansi_sequence(attrs_t attrs, std::wstring& output) noexcept -> void;
+
+		HANDLE m_Output{};
+		mode m_Mode{ mode::win32 };
+		bool m_IsConsole{};
+		bool m_RestoreMode{};   // attach 时开启了虚拟终端序列，需要恢复 m_ConsoleMode
+		DWORD m_ConsoleMode{};  // attach 之前的控制台模式
+
+		std::wstring m_Text{};
+		std::vector<span> m_Spans{};
+		std::wstring m_Sequence{}; // ansi 模式下拼接转义序列后的文本
+		std::string  m_Bytes{};    // 输出不是控制台时转换成的 UTF-8
+
+		std::chrono::steady_clock::time_point m_LastFlush{};
+		mutable std::mutex m_Mutex{};
+		std::condition_variable_any m_Pending{}; // 有新的文本等待写出时通知计时线程
+		std::jthread m_Timer{}; // 第一次有文本滞留时才启动，放在最后使其最先析构
+	};
 
 	class console_helper
 	{
@@ -190,6 +276,7 @@ namespace console
 		HWND  m_Window{};
 		HANDLE m_Output{};
 		HANDLE m_Input{};
+		mutable console_batch m_Batch{};
 
 		auto vf_write(const char*     fmt, va_list arg_list) const noexcept -> const console_helper&;
 		auto vf_write(const wchar_t*  fmt, va_list arg_list) const noexcept -> const console_helper&;
@@ -217,6 +304,10 @@ namespace console
 
 		auto read_anykey() const noexcept -> const console_helper&;
 
+		// 批量输出与直接输出共用同一个控制台，直接输出、设置颜色、清屏和等待按键前都会先写出批量输出中剩余的内容
+		auto batch() const noexcept -> console_batch&;
+		auto flush() const noexcept -> const console_helper&;
+
 		auto write(std::wstring_view content) const noexcept -> const console_helper&;
 		auto write(std::string_view  content) const noexcept -> const console_helper&;
 		auto write(uint32_t cdpg, std::string_view  content) const noexcept -> const console_helper&;
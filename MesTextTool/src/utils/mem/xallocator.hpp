@@ -0,0 +1,28 @@
+#pragma once
+#define _xallocator_
+#include <memory>
+#include <type_traits>
+
+namespace utils::xmem {
+
+	// 只分配、不做值初始化的分配器：扩容时新增的尾部不会被清零，写入前的内容是未定义的，由调用者负责写入
+	template<class T>
+	class default_init_allocator : public std::allocator<T>
+	{
+	public:
+		using value_type = T;
+		using std::allocator<T>::allocator;
+
+		template<class U>
+		inline auto construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) -> void
+		{
+			::new(static_cast<void*>(ptr)) U;
+		}
+
+		template<class U, class ...args_t>
+		inline auto construct(U* ptr, args_t&& ...args) -> void
+		{
+			::new(static_cast<void*>(ptr)) U(std::forward<args_t>(args)...);
+		}
+	};
+}
@@ -2,6 +2,12 @@
 #define _xmemory_
 #include <vector>
 #include <span>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <memory_resource>
+#include <algorithm>
+#include "xallocator.hpp"
 
 namespace utils::xmem {
 
@@ -25,9 +31,12 @@ namespace utils::xmem {
 	template<class elem_t>
 	class buffer
 	{
+	public:
+		using storage_t = std::vector<elem_t, default_init_allocator<elem_t>>;
+
 	protected:
 
-		std::vector<elem_t> m_Buffer{};
+		storage_t m_Buffer{};
 		size_t m_Count{};
 
 		auto check(const size_t length) -> buffer&;
@@ -35,7 +44,7 @@ namespace utils::xmem {
 	public:
 
 		static constexpr inline auto unused{ static_cast<size_t>(-1) };
-		using iterator = typename std::vector<elem_t>::iterator;
+		using iterator = typename storage_t::iterator;
 
 		 buffer() = default;
 		~buffer() = default;
@@ -137,12 +146,15 @@ namespace utils::xmem {
 
 		auto recount(size_t count = 0) -> buffer&;
 
-		auto resize(size_t size) -> buffer&;
+		// initialize 为 false 时新增的部分不清零，适合随后会被完整覆盖的场景（如读取文件）
+		auto resize(size_t size, bool initialize = true) -> buffer&;
 
 		auto count() const -> size_t;
 
 		auto size() const -> size_t;
 
+		auto capacity() const -> size_t;
+
 		auto clear() -> buffer&;
 
 		auto begin() -> iterator;
@@ -163,7 +175,7 @@ namespace utils::xmem {
 	template<class elem_t>
 	inline buffer<elem_t>::buffer(size_t size)
 	{
-		this->m_Buffer.resize(size);
+		this->m_Buffer.resize(size, elem_t{});
 	}
 
 	template<class elem_t>
@@ -184,8 +196,9 @@ namespace utils::xmem {
 		size_t count{ this->m_Count + length };
 		if (count > this->m_Buffer.size())
 		{
-			size_t size{ (count + 1023) & ~1023 };
-			this->m_Buffer.resize(size);
+			// 按 1.5 倍增长，新增部分马上会被写入，不需要清零
+			const size_t growth{ std::max(count, this->m_Buffer.size() + this->m_Buffer.size() / 2) };
+			this->m_Buffer.resize((growth + 1023) & ~size_t{ 1023 });
 		}
 		return *this;
 	}
@@ -377,7 +390,8 @@ namespace utils::xmem {
 		{
 			size_t length = (offset - this->m_Count) + size;
 			this->check(length);
-			this->m_Count = length;
+			std::fill(this->begin() + this->m_Count, this->begin() + offset, elem_t{}); // 空出的部分补 0
+			this->m_Count += length;
 		}
 		else if (overwrite)
 		{
@@ -416,7 +430,8 @@ namespace utils::xmem {
 		{
 			size_t length = (offset - this->m_Count) + count;
 			this->check(length);
-			this->m_Count = length;
+			std::fill(this->begin() + this->m_Count, this->begin() + offset, elem_t{});
+			this->m_Count += length;
 		}
 		else if (overwrite)
 		{
@@ -457,7 +472,7 @@ namespace utils::xmem {
 	{
 		if (count > this->m_Buffer.size()) 
 		{
-			this->m_Buffer.resize(count);
+			this->resize(count);
 		}
 		this->m_Count = count;
 
@@ -465,9 +480,14 @@ namespace utils::xmem {
 	}
 
 	template<class elem_t>
-	inline auto buffer<elem_t>::resize(size_t size) -> buffer&
+	inline auto buffer<elem_t>::resize(size_t size, bool initialize) -> buffer&
 	{
+		const size_t o_size{ this->m_Buffer.size() };
 		this->m_Buffer.resize(size);
+		if (initialize && size > o_size)
+		{
+			std::fill(this->m_Buffer.begin() + o_size, this->m_Buffer.end(), elem_t{});
+		}
 		if (size < this->m_Count) 
 		{
 			this->m_Count = size;
@@ -487,6 +507,12 @@ namespace utils::xmem {
 		return this->m_Buffer.size();
 	}
 
+	template<class elem_t>
+	inline auto buffer<elem_t>::capacity() const -> size_t
+	{
+		return this->m_Buffer.capacity();
+	}
+
 	template<class elem_t>
 	inline auto buffer<elem_t>::clear() -> buffer&
 	{
@@ -565,4 +591,305 @@ namespace utils::xmem {
 		return result;
 	}
 
+	// 线程安全的 buffer 池：处理一批大小相近的文件时反复使用同一批内存，稳定后不再分配；
+	// 池中保留的 buffer 个数与总字节数都有上限，单个超过 max_buffer 字节的 buffer 不放入池中，直接释放
+	template<class elem_t>
+	class buffer_pool
+	{
+	public:
+
+		inline static constexpr size_t default_limit     { 16 };
+		inline static constexpr size_t default_max_bytes { size_t{ 128 } << 20 };
+		inline static constexpr size_t default_max_buffer{ size_t{ 32  } << 20 };
+
+		// 预留好上限加一个位置，release 放入 buffer 时不会再分配
+		inline buffer_pool(size_t limit = default_limit, size_t max_bytes = default_max_bytes, size_t max_buffer = default_max_buffer)
+			: m_Limit{ limit }, m_MaxBytes{ max_bytes }, m_MaxBuffer{ std::min(max_buffer, max_bytes) } { this->m_Free.reserve(limit + 1); };
+
+		// 取出容量最接近且不小于 size 的 buffer，没有足够大的时重新分配，池中的 buffer 保持不动；
+		// 返回的 buffer 长度为 size，内容未初始化
+		auto acquire(size_t size) -> buffer<elem_t>;
+
+		// 归还 buffer 的内存：过大的 buffer 直接释放；放入后超过个数或总字节数的上限时，从容量最小的开始丢弃。
+		// 调用后 buffer 总是为空
+		auto release(buffer<elem_t>&& buffer) noexcept -> void;
+
+		auto clear() -> void;
+
+		auto bytes() const noexcept -> size_t; // 池中保留的总字节数
+
+		static auto shared() -> buffer_pool&;
+
+	protected:
+
+		mutable std::mutex m_Mutex{};
+		std::vector<buffer<elem_t>> m_Free{};
+		size_t m_Limit{};
+		size_t m_MaxBytes{};
+		size_t m_MaxBuffer{};
+		size_t m_Bytes{};
+	};
+
+	template<class elem_t>
+	inline auto buffer_pool<elem_t>::acquire(size_t size) -> buffer<elem_t>
+	{
+		buffer<elem_t> result{};
+		{
+			const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+			auto found{ this->m_Free.end() };
+			for (auto it{ this->m_Free.begin() }; it != this->m_Free.end(); ++it)
+			{
+				if (it->capacity() >= size && (found == this->m_Free.end() || it->capacity() < found->capacity()))
+				{
+					found = it;
+				}
+			}
+
+			if (found != this->m_Free.end())
+			{
+				this->m_Bytes -= found->capacity() * sizeof(elem_t);
+				result = std::move(*found);
+				this->m_Free.erase(found);
+			}
+		}
+
+		result.recount(0);
+		result.resize(size, false);
+		return result;
+	}
+
+	template<class elem_t>
+	inline auto buffer_pool<elem_t>::release(buffer<elem_t>&& buffer) noexcept -> void
+	{
+		// 移出到局部变量：无论是否放入池中，调用者手里的 buffer 都变为空，丢弃的内存在离开作用域时释放
+		xmem::buffer<elem_t> released{ std::move(buffer) };
+		const size_t bytes{ released.capacity() * sizeof(elem_t) };
+		if (bytes == 0 || bytes > this->m_MaxBuffer || this->m_Limit == 0)
+		{
+			return;
+		}
+
+		// m_Free 的大小放入后最多为上限加一，构造时已经预留，push_back 不会分配；
+		// max_buffer 不大于 max_bytes，从容量最小的开始丢弃，总能回到上限以内
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->m_Free.push_back(std::move(released));
+		this->m_Bytes += bytes;
+		while (this->m_Free.size() > this->m_Limit || this->m_Bytes > this->m_MaxBytes)
+		{
+			const auto smallest{ std::ranges::min_element(this->m_Free, {}, &xmem::buffer<elem_t>::capacity) };
+			this->m_Bytes -= smallest->capacity() * sizeof(elem_t);
+			this->m_Free.erase(smallest);
+		}
+	}
+
+	template<class elem_t>
+	inline auto buffer_pool<elem_t>::clear() -> void
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->m_Free.clear();
+		this->m_Bytes = 0;
+	}
+
+	template<class elem_t>
+	inline auto buffer_pool<elem_t>::bytes() const noexcept -> size_t
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		return this->m_Bytes;
+	}
+
+	template<class elem_t>
+	inline auto buffer_pool<elem_t>::shared() -> buffer_pool&
+	{
+		static buffer_pool pool{};
+		return pool;
+	}
+
+	// 多个工作线程共享的内存预算：acquire 在超出上限时阻塞，直到其他线程 release，使并行任务的总占用不超过上限
+	// 单个请求大于整个上限时，只要当前没有其他占用就放行，避免永远等待
+	class budget
+	{
+	public:
+
+		inline explicit budget(size_t limit) noexcept : m_Limit{ limit } {};
+
+		budget(const budget&) = delete;
+		auto operator=(const budget&) -> budget& = delete;
+
+		auto acquire(size_t bytes) -> void;
+
+		// 不阻塞，允许暂时超出上限：已经开始的任务需要更多内存时使用，之后的 acquire 会等待它释放
+		auto charge(size_t bytes) noexcept -> void;
+
+		auto release(size_t bytes) noexcept -> void;
+
+		inline auto limit() const noexcept -> size_t;
+		inline auto used () const noexcept -> size_t;
+		inline auto peak () const noexcept -> size_t;
+
+	protected:
+
+		mutable std::mutex m_Mutex{};
+		std::condition_variable m_Released{};
+		size_t m_Limit{};
+		size_t m_Used{};
+		size_t m_Peak{};
+	};
+
+	// 按作用域持有一部分预算，析构时全部归还；budget 为空时不做任何记录
+	class budget_lease
+	{
+	public:
+
+		inline budget_lease() noexcept {};
+		inline budget_lease(budget* budget, size_t bytes);
+		inline ~budget_lease() noexcept;
+
+		budget_lease(const budget_lease&) = delete;
+		auto operator=(const budget_lease&) -> budget_lease& = delete;
+
+		inline auto grow(size_t bytes) noexcept -> void; // 追加 bytes，不阻塞
+		inline auto shrink(size_t bytes) noexcept -> void; // 提前归还一部分，最多归还到 0
+		// 先归还持有的全部预算，再按 bytes 重新申请，预算不足时等待；等待期间不占用预算，任务之间不会互相等待
+		inline auto reset(size_t bytes) -> void;
+		inline auto bytes() const noexcept -> size_t;
+
+	protected:
+
+		budget* m_Budget{};
+		size_t  m_Bytes{};
+	};
+
+	inline auto budget::acquire(size_t bytes) -> void
+	{
+		std::unique_lock<std::mutex> lock{ this->m_Mutex };
+		this->m_Released.wait(lock, [this, bytes]() -> bool
+		{
+			return this->m_Used == 0 || this->m_Used + bytes <= this->m_Limit;
+		});
+		this->m_Used += bytes;
+		this->m_Peak  = std::max(this->m_Peak, this->m_Used);
+	}
+
+	inline auto budget::charge(size_t bytes) noexcept -> void
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		this->m_Used += bytes;
+		this->m_Peak  = std::max(this->m_Peak, this->m_Used);
+	}
+
+	inline auto budget::release(size_t bytes) noexcept -> void
+	{
+		{
+			const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+			this->m_Used -= std::min(bytes, this->m_Used);
+		}
+		this->m_Released.notify_all();
+	}
+
+	inline auto budget::limit() const noexcept -> size_t
+	{
+		return this->m_Limit;
+	}
+
+	inline auto budget::used() const noexcept -> size_t
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		return this->m_Used;
+	}
+
+	inline auto budget::peak() const noexcept -> size_t
+	{
+		const std::lock_guard<std::mutex> lock{ this->m_Mutex };
+		return this->m_Peak;
+	}
+
+	inline budget_lease::budget_lease(budget* budget, size_t bytes) : m_Budget{ budget }
+	{
+		if (this->m_Budget != nullptr)
+		{
+			this->m_Budget->acquire(bytes);
+			this->m_Bytes = bytes;
+		}
+	}
+
+	inline budget_lease::~budget_lease() noexcept
+	{
+		if (this->m_Budget != nullptr && this->m_Bytes != 0)
+		{
+			this->m_Budget->release(this->m_Bytes);
+		}
+	}
+
+	inline auto budget_lease::grow(size_t bytes) noexcept -> void
+	{
+		if (this->m_Budget != nullptr)
+		{
+			this->m_Budget->charge(bytes);
+			this->m_Bytes += bytes;
+		}
+	}
+
+	inline auto budget_lease::shrink(size_t bytes) noexcept -> void
+	{
+		bytes = std::min(bytes, this->m_Bytes);
+		if (this->m_Budget != nullptr && bytes != 0)
+		{
+			this->m_Budget->release(bytes);
+			this->m_Bytes -= bytes;
+		}
+	}
+
+	inline auto budget_lease::reset(size_t bytes) -> void
+	{
+		if (this->m_Budget != nullptr)
+		{
+			this->shrink(this->m_Bytes);
+			this->m_Budget->acquire(bytes);
+			this->m_Bytes = bytes;
+		}
+	}
+
+	inline auto budget_lease::bytes() const noexcept -> size_t
+	{
+		return this->m_Bytes;
+	}
+
+	// 把从 upstream 分配的内存记入 lease，释放时从 lease 中归还；作为 monotonic_buffer_resource 等的上游时，
+	// 按实际向系统申请的块计数。记入不阻塞，需要等待的大块应先用 budget_lease::reset 申请
+	class budget_resource : public std::pmr::memory_resource
+	{
+	public:
+
+		inline budget_resource(budget_lease* lease, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+			: m_Lease{ lease }, m_Upstream{ upstream } {};
+
+	protected:
+
+		inline auto do_allocate(size_t bytes, size_t alignment) -> void* override
+		{
+			void* const result{ this->m_Upstream->allocate(bytes, alignment) };
+			if (this->m_Lease != nullptr)
+			{
+				this->m_Lease->grow(bytes);
+			}
+			return result;
+		}
+
+		inline auto do_deallocate(void* ptr, size_t bytes, size_t alignment) -> void override
+		{
+			this->m_Upstream->deallocate(ptr, bytes, alignment);
+			if (this->m_Lease != nullptr)
+			{
+				this->m_Lease->shrink(bytes);
+			}
+		}
+
+		inline auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+		{
+			return this == &other;
+		}
+
+		budget_lease* m_Lease{};
+		std::pmr::memory_resource* m_Upstream{};
+	};
 }
\ No newline at end of file
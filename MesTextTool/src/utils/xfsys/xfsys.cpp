@@ -750,6 +750,54 @@ namespace xfsys
 		return xfsys::is_exists(*reinterpret_cast<const std::wstring_view*>(&path));
 	}
 
+	auto remove(const std::string_view path) -> bool
+	{
+		const std::string target_path{ path };
+		return { ::DeleteFileA(target_path.data()) != FALSE };
+	}
+
+	auto remove(const std::wstring_view path) -> bool
+	{
+		const std::wstring target_path{ path };
+		return { ::DeleteFileW(target_path.data()) != FALSE };
+	}
+
+	auto remove(const std::u8string_view path) -> bool
+	{
+		return xfsys::remove(to_wstring(*reinterpret_cast<const std::string_view*>(&path), CP_UTF8));
+	}
+
+	auto remove(const std::u16string_view path) -> bool
+	{
+		return xfsys::remove(*reinterpret_cast<const std::wstring_view*>(&path));
+	}
+
+	auto rename(const std::string_view from, const std::string_view to) -> bool
+	{
+		const std::string source_path{ from }, target_path{ to };
+		return { ::MoveFileExA(source_path.data(), target_path.data(), MOVEFILE_REPLACE_EXISTING) != FALSE };
+	}
+
+	auto rename(const std::wstring_view from, const std::wstring_view to) -> bool
+	{
+		const std::wstring source_path{ from }, target_path{ to };
+		return { ::MoveFileExW(source_path.data(), target_path.data(), MOVEFILE_REPLACE_EXISTING) != FALSE };
+	}
+
+	auto rename(const std::u8string_view from, const std::u8string_view to) -> bool
+	{
+		return xfsys::rename
+		(
+			to_wstring(*reinterpret_cast<const std::string_view*>(&from), CP_UTF8),
+			to_wstring(*reinterpret_cast<const std::string_view*>(&to), CP_UTF8)
+		);
+	}
+
+	auto rename(const std::u16string_view from, const std::u16string_view to) -> bool
+	{
+		return xfsys::rename(*reinterpret_cast<const std::wstring_view*>(&from), *reinterpret_cast<const std::wstring_view*>(&to));
+	}
+
 	auto file::write(const void* buffer, size_t count, pos::method relative,
 		size_t offset) const noexcept -> size_t
 	{
@@ -850,6 +898,49 @@ namespace xfsys
 		this->m_handle = nullptr;
 	}
 
+	mapping::mapping(const file& file) noexcept
+	{
+		if (!file.is_open())
+		{
+			return;
+		}
+
+		const size_t size{ file.size() };
+		if (size == 0)
+		{
+			return;
+		}
+
+		this->m_handle = ::CreateFileMappingW(file.m_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (this->m_handle == nullptr)
+		{
+			return;
+		}
+
+		this->m_data = static_cast<const uint8_t*>(::MapViewOfFile(this->m_handle, FILE_MAP_READ, 0, 0, 0));
+		if (this->m_data == nullptr)
+		{
+			this->close();
+			return;
+		}
+		this->m_size = size;
+	}
+
+	auto mapping::close() noexcept -> void
+	{
+		if (this->m_data != nullptr)
+		{
+			::UnmapViewOfFile(this->m_data);
+		}
+		if (this->m_handle != nullptr)
+		{
+			::CloseHandle(this->m_handle);
+		}
+		this->m_handle = nullptr;
+		this->m_data   = nullptr;
+		this->m_size   = 0;
+	}
+
 	auto file::path_of_string() const noexcept -> std::string
 	{
 		if (!this->is_open())
@@ -2,6 +2,7 @@
 #include <windows.h>
 #include <algorithm>
 #include <vector>
+#include <utility>
 
 namespace xfsys 
 {
@@ -35,8 +36,11 @@ namespace xfsys
 		std::is_same_v<std::decay_t<T>, std::u8string > ||
 		std::is_same_v<std::decay_t<T>, std::u16string>;
 
+	class mapping;
+
 	class file
 	{
+		friend mapping;
 		using handle_t = void*;
 		
 		mutable handle_t m_handle{};
@@ -247,6 +251,67 @@ namespace xfsys
 		return {};
 	}
 
+	// 只读映射整个文件，映射期间 file 可以先行关闭
+	class mapping
+	{
+		using handle_t = void*;
+
+		handle_t m_handle{};
+		const uint8_t* m_data{};
+		size_t m_size{};
+
+	public:
+
+		inline mapping() noexcept = default;
+		inline ~mapping() noexcept { this->close(); };
+
+		inline mapping(const mapping& other) noexcept = delete;
+		inline mapping& operator=(const mapping& other) = delete;
+
+		inline mapping(mapping&& other) noexcept;
+		inline auto operator=(mapping&& other) noexcept -> mapping&;
+
+		mapping(const file& file) noexcept;
+
+		inline auto data() const noexcept -> const uint8_t*;
+		inline auto size() const noexcept -> size_t;
+		inline auto is_open() const noexcept -> bool;
+
+		auto close() noexcept -> void;
+	};
+
+	inline mapping::mapping(mapping&& other) noexcept
+	{
+		this->operator=(std::move(other));
+	}
+
+	inline auto mapping::operator=(mapping&& other) noexcept -> mapping&
+	{
+		if (this != &other)
+		{
+			this->close();
+			this->m_handle = std::exchange(other.m_handle, nullptr);
+			this->m_data   = std::exchange(other.m_data, nullptr);
+			this->m_size   = std::exchange(other.m_size, 0);
+		}
+		return *this;
+	}
+
+	inline auto mapping::data() const noexcept -> const uint8_t*
+	{
+		return this->m_data;
+	}
+
+	inline auto mapping::size() const noexcept -> size_t
+	{
+		return this->m_size;
+	}
+
+	inline auto mapping::is_open() const noexcept -> bool
+	{
+		return this->m_data != nullptr;
+	}
+
 	namespace path 
 	{
 
@@ -880,4 +945,17 @@ namespace xfsys
 
 	auto is_exists(const std::u8string_view  path) -> bool;
 	auto is_exists(const std::u16string_view path) -> bool;
+
+	auto remove(const std::string_view  path) -> bool;
+	auto remove(const std::wstring_view path) -> bool;
+
+	auto remove(const std::u8string_view  path) -> bool;
+	auto remove(const std::u16string_view path) -> bool;
+
+	// 同一卷内的替换是原子的：to 已存在时直接覆盖，其他进程只会看到旧文件或新文件
+	auto rename(const std::string_view  from, const std::string_view  to) -> bool;
+	auto rename(const std::wstring_view from, const std::wstring_view to) -> bool;
+
+	auto rename(const std::u8string_view  from, const std::u8string_view  to) -> bool;
+	auto rename(const std::u16string_view from, const std::u16string_view to) -> bool;
 }
\ No newline at end of file
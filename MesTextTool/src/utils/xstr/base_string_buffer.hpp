@@ -2,10 +2,23 @@
 #define _base_string_buffer_
 #include <vector>
 #include <ranges>
+#include <memory>
+#include <format>
+#include <cstdio>
+#include <cstdarg>
+#include <algorithm>
+#include "string_search.hpp"
+#include "string_split.hpp"
+#include <xallocator.hpp>
 
 namespace utils::xstr 
 {
 
+	using utils::xmem::default_init_allocator;
+
+	template<class elem_t>
+	using string_vector = std::vector<elem_t, default_init_allocator<elem_t>>;
+
 	template <class T, class elem_t>
 	concept valid_iterator_t = requires(T it) 
 	{
@@ -43,11 +56,12 @@ namespace utils::xstr
 
 		using view_t   = std::basic_string_view<elem_t, std::char_traits<elem_t>>;
 		using string_t = std::basic_string<elem_t, std::char_traits<elem_t>, std::allocator<elem_t>>;
-		using vector_t = std::vector<elem_t>;
+		using vector_t = xstr::string_vector<elem_t>;
 
 		static constexpr inline elem_t empty[] { static_cast<elem_t>( 0) };
 		static constexpr inline auto npos      { view_t::npos };
 		static constexpr inline auto unused    { static_cast<size_t>(-1) };
+		static constexpr inline auto min_growth{ static_cast<size_t>(1024) };
 		static constexpr inline const elem_t whitespace[]
 		{
 			static_cast<elem_t>( ' '),
@@ -99,12 +113,31 @@ namespace utils::xstr
 
 		auto write_as_format(const elem_t* fmt, ...) -> void;
 
+		// std::format 的字符类型按元素大小选择：1 字节的元素用 char，与 wchar_t 大小相同的元素用 wchar_t
+		using format_char_t = std::conditional_t<sizeof(elem_t) == sizeof(char), char, wchar_t>;
+
+		template<class ...args_t>
+		using format_string_t = std::basic_format_string<format_char_t, std::type_identity_t<args_t>...>;
+
+		class format_iterator;
+
+		// 格式串在编译期检查，结果直接写入缓冲区的剩余空间，不需要先计算长度
+		template<class ...args_t>
+		requires (sizeof(elem_t) == sizeof(char) || sizeof(elem_t) == sizeof(wchar_t))
+		auto format(const format_string_t<args_t...> fmt, args_t&& ...args) -> void;
+
 		auto write(const view_t str) -> void;
 
 		auto write(elem_t elem) -> void;
 
 		auto resize(size_t size) -> void;
 
+		auto reserve(size_t count) -> void;
+
+		auto shrink_to_fit() -> void;
+
+		auto capacity() const noexcept -> size_t;
+
 		auto data() const noexcept -> elem_t*;
 
 		auto  raw() noexcept -> vector_t&;
@@ -125,6 +158,16 @@ namespace utils::xstr
 
 		auto split(xstr::union_convertible_of<elem_t, view_t> auto elem, size_t count = unused) -> std::vector<view_t>;
 
+		// 惰性切分：遍历时才查找下一段，不分配内存，结果引用缓冲区中的内容，缓冲区被修改后失效
+		auto lazy_split(xstr::union_convertible_of<elem_t, view_t> auto elem, size_t count = unused) const noexcept -> xstr::split_range<elem_t>;
+
+		auto lazy_split_of(std::span<const view_t> strings, size_t count = unused) const noexcept -> xstr::split_of_range<elem_t, std::span<const view_t>>;
+
+		auto lazy_split_of(
+			xstr::union_convertible_of<elem_t, view_t> auto one,
+			xstr::union_convertible_of<elem_t, view_t> auto ...more
+		) const noexcept -> xstr::split_of_range<elem_t, std::array<xstr::separator<elem_t>, sizeof...(more) + 1>>;
+
 		auto split_of(std::initializer_list<view_t> strings, size_t count = unused) -> std::vector<view_t>;
 
 		auto split_of(
@@ -183,6 +226,7 @@ namespace utils::xstr
 		if (size != 0) 
 		{
 			this->m_Buffer.resize(size);
+			this->m_Buffer[0] = empty[0];
 		}
 	}
 
@@ -198,10 +242,15 @@ namespace utils::xstr
 		const size_t count { this->m_CharCount + length + 1 };
 		if (count > this->m_Buffer.capacity()) 
 		{
-			const size_t size{ (count + 1023) & ~1023 };
-			this->m_Buffer.reserve(size);
+			// 按 1.5 倍增长，至少 1 KiB 对齐，连续追加时复制次数为对数级
+			const size_t capacity{ this->m_Buffer.capacity() };
+			const size_t growth  { std::max(count, capacity + capacity / 2) };
+			this->m_Buffer.reserve((growth + (min_growth - 1)) & ~(min_growth - 1));
+		}
+		if (this->m_Buffer.size() != this->m_Buffer.capacity())
+		{
+			this->m_Buffer.resize(this->m_Buffer.capacity()); // 不清零，只调整 size
 		}
-		this->m_Buffer.resize(this->m_Buffer.capacity());
 	}
 
 	template<class elem_t>
@@ -230,42 +279,97 @@ namespace utils::xstr
 			"Format unsupported string element type."
 		);
 
-		if constexpr (elem_size == sizeof(char))
+		// 先直接写入剩余空间，大多数情况下一次完成；放不下时才按需要的长度扩容后再写一次
+		const auto print = [this, fmt](va_list args) -> int
 		{
-			va_list args{ nullptr };
-			__crt_va_start(args, fmt);
+			const size_t space{ this->m_Buffer.size() - this->m_CharCount };
+			auto&& buffer = &this->m_Buffer[this->m_CharCount];
+			if constexpr (elem_size == sizeof(char))
+			{
+				return std::vsnprintf(reinterpret_cast<char*>(buffer), space, reinterpret_cast<const char*>(fmt), args);
+			}
+			else
+			{
+				return std::vswprintf(reinterpret_cast<wchar_t*>(buffer), space, reinterpret_cast<const wchar_t*>(fmt), args);
+			}
+		};
 
-			auto&& c_fmt  = reinterpret_cast<const char*>(fmt);
-			size_t length = std::vsnprintf(nullptr, 0, c_fmt, args);
-			this->check(length);
+		va_list args{};
+		va_start(args, fmt);
+		this->check(0);
 
-			auto&& buffer = &this->m_Buffer[this->m_CharCount];
-			size_t size   = this->m_Buffer.size() - this->m_CharCount;
-			std::vsnprintf(reinterpret_cast<char*>(buffer), size, c_fmt, args);
+		va_list copy{};
+		va_copy(copy, args);
+		int length{ print(copy) };
+		va_end(copy);
 
-			this->m_CharCount = this->m_CharCount + length;
-			this->m_Buffer[this->m_CharCount] = empty[0];
+		if (length < 0 || static_cast<size_t>(length) >= this->m_Buffer.size() - this->m_CharCount)
+		{
+			// vswprintf 在空间不足时只返回 -1，需要单独计算长度
+			if constexpr (elem_size != sizeof(char))
+			{
+				va_copy(copy, args);
+				length = std::vswprintf(nullptr, 0, reinterpret_cast<const wchar_t*>(fmt), copy);
+				va_end(copy);
+			}
 
-			__crt_va_end(args);
+			if (length >= 0)
+			{
+				this->check(static_cast<size_t>(length));
+				va_copy(copy, args);
+				length = print(copy);
+				va_end(copy);
+			}
 		}
-		else if constexpr (elem_size == sizeof(wchar_t))
+		va_end(args);
+
+		if (length > 0)
 		{
-			va_list args{ nullptr };
-			__crt_va_start(args, fmt);
+			this->m_CharCount = this->m_CharCount + static_cast<size_t>(length);
+		}
+		this->m_Buffer[this->m_CharCount] = empty[0];
+	}
 
-			auto&& c_fmt  = reinterpret_cast<const wchar_t*>(fmt);
-			size_t length = std::vswprintf(nullptr, 0, c_fmt, args);
-			this->check(length);
+	// 逐个字符写入 m_Buffer 的剩余空间，空间用完时按 check 的策略扩容，结尾的 0 由 format 最后补上
+	template<class elem_t>
+	class base_string_buffer<elem_t>::format_iterator
+	{
+		base_string_buffer* m_buffer;
 
-			auto&& buffer = &this->m_Buffer[this->m_CharCount];
-			size_t size   = this->m_Buffer.size() - this->m_CharCount;
-			std::vswprintf(reinterpret_cast<wchar_t*>(buffer), size, c_fmt, args);
+	public:
 
-			this->m_CharCount = this->m_CharCount + length;
-			this->m_Buffer[this->m_CharCount] = empty[0];
+		using iterator_category = std::output_iterator_tag;
+		using value_type        = void;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = void;
+		using reference         = void;
 
-			__crt_va_end(args);
+		inline explicit format_iterator(base_string_buffer* buffer) noexcept : m_buffer{ buffer } {}
+
+		inline auto operator=(const format_char_t chr) -> format_iterator&
+		{
+			base_string_buffer& buffer{ *this->m_buffer };
+			if (buffer.m_CharCount + 1 >= buffer.m_Buffer.size())
+			{
+				buffer.check(1);
+			}
+			buffer.m_Buffer[buffer.m_CharCount++] = static_cast<elem_t>(chr);
+			return *this;
 		}
+
+		inline auto operator* () noexcept -> format_iterator& { return *this; }
+		inline auto operator++() noexcept -> format_iterator& { return *this; }
+		inline auto operator++(int) noexcept -> format_iterator { return *this; }
+	};
+
+	template<class elem_t>
+	template<class ...args_t>
+	requires (sizeof(elem_t) == sizeof(char) || sizeof(elem_t) == sizeof(wchar_t))
+	auto base_string_buffer<elem_t>::format(const format_string_t<args_t...> fmt, args_t&& ...args) -> void
+	{
+		this->check(fmt.get().size());
+		std::format_to(format_iterator{ this }, fmt, std::forward<args_t>(args)...);
+		this->m_Buffer[this->m_CharCount] = empty[0];
 	}
 
 	template<class elem_t>
@@ -288,12 +392,50 @@ namespace utils::xstr
 	{
 		if (this->m_Buffer.size() != size + 1)
 		{
+			const bool was_empty{ this->m_Buffer.empty() };
 			this->m_Buffer.resize(size + 1);
+			if (was_empty)
+			{
+				this->m_Buffer[0] = empty[0]; // 新分配的内存没有初始化，recount 需要一个结尾
+			}
 			this->m_Buffer[size] = static_cast<elem_t>(0);
 			this->recount();
 		}
 	}
 
+	template<class elem_t>
+	inline auto base_string_buffer<elem_t>::reserve(size_t count) -> void
+	{
+		if (count + 1 > this->m_Buffer.size())
+		{
+			const bool was_empty{ this->m_Buffer.empty() };
+			this->m_Buffer.reserve(count + 1);
+			this->m_Buffer.resize(this->m_Buffer.capacity());
+			if (was_empty)
+			{
+				this->m_Buffer[0] = empty[0];
+			}
+		}
+	}
+
+	template<class elem_t>
+	inline auto base_string_buffer<elem_t>::shrink_to_fit() -> void
+	{
+		if (this->m_Buffer.empty())
+		{
+			return;
+		}
+		this->m_Buffer.resize(this->m_CharCount + 1);
+		this->m_Buffer.shrink_to_fit();
+		this->m_Buffer[this->m_CharCount] = empty[0];
+	}
+
+	template<class elem_t>
+	inline auto base_string_buffer<elem_t>::capacity() const noexcept -> size_t
+	{
+		return this->m_Buffer.empty() ? 0 : this->m_Buffer.size() - 1;
+	}
+
 	template<class elem_t>
 	inline auto base_string_buffer<elem_t>::data() const noexcept -> elem_t*
 	{
@@ -445,36 +587,9 @@ namespace utils::xstr
 	inline auto base_string_buffer<elem_t>::split(xstr::union_convertible_of<elem_t, view_t> auto elem, size_t count) -> std::vector<view_t>
 	{
 		std::vector<view_t> result{};
-		view_t string { xstr::convert_to_view<elem_t>(elem) };
-		view_t view   { this->m_Buffer.data(), this->m_CharCount };
-
-		if (!string.empty() && !view.empty())
+		for (const auto piece : this->lazy_split(elem, count))
 		{
-			for (size_t current{ 0 }, found{ 0 }; current < view.size();)
-			{
-				size_t pos = view.find(string, current);
-				if (pos == npos)
-				{
-					auto length{ static_cast<size_t>(view.size() - current) };
-					auto substr{ view.substr(current, length) };
-					result.push_back(substr);
-					break;
-				}
-
-				auto length{ static_cast<size_t>(pos - current) };
-				auto substr{ view.substr(current, length) };
-				result.push_back(substr);
-
-				if (++found == count)
-				{
-					break;
-				}
-				current = pos + string.size();
-			}
-		}
-		else
-		{
-			result.push_back(view);
+			result.push_back(piece);
 		}
 		return result;
 	}
@@ -482,52 +597,50 @@ namespace utils::xstr
 	template<class elem_t>
 	inline auto base_string_buffer<elem_t>::split_of(std::initializer_list<view_t> strings, size_t count) -> std::vector<view_t>
 	{
-		
 		std::vector<view_t> result{};
-		view_t view{ this->m_Buffer.data(), this->m_CharCount };
-		
-		if (strings.size() > 0)
+		for (const auto piece : this->lazy_split_of(std::span<const view_t>{ strings.begin(), strings.size() }, count))
 		{
-			for (size_t beg{ 0 }, end{ 0 }, found{ 0 }; end <= view.size(); ++end)
-			{
-				bool is_sep{ false };
-				for (const view_t& sep : strings)
-				{
-					auto split{ view.substr(end, sep.size()) };
-					if (split == sep)
-					{
-						is_sep = true;
-						auto substr{ view.substr(beg, end - beg) };
-						result.push_back(substr);
-
-						end = end + sep.size();
-						beg = end;
-						found++;
-						break;
-					}
-				}
-
-				if (!is_sep && end == view.size())
-				{
-					auto substr{ view.substr(beg, end - beg) };
-					result.push_back(substr);
-				}
-				else if(found == count)
-				{
-					auto substr{ view.substr(end, view.size() - end) };
-					result.push_back(substr);
-					break;
-				}
-			}
+			result.push_back(piece);
 		}
-		else 
+		return result;
+	}
+
+	template<class elem_t>
+	inline auto base_string_buffer<elem_t>::lazy_split(xstr::union_convertible_of<elem_t, view_t> auto elem, size_t count) const noexcept -> xstr::split_range<elem_t>
+	{
+		return xstr::split_range<elem_t>
 		{
-			result.push_back(view);
-		}
+			view_t{ this->m_Buffer.data(), this->m_CharCount },
+			xstr::separator<elem_t>{ elem },
+			count
+		};
+	}
 
-		return result;
+	template<class elem_t>
+	inline auto base_string_buffer<elem_t>::lazy_split_of(std::span<const view_t> strings, size_t count) const noexcept -> xstr::split_of_range<elem_t, std::span<const view_t>>
+	{
+		return xstr::split_of_range<elem_t, std::span<const view_t>>
+		{
+			view_t{ this->m_Buffer.data(), this->m_CharCount }, strings, count
+		};
 	}
 
+	template<class elem_t>
+	inline auto base_string_buffer<elem_t>::lazy_split_of(
+		xstr::union_convertible_of<elem_t, view_t> auto one,
+		xstr::union_convertible_of<elem_t, view_t> auto ...more
+	) const noexcept -> xstr::split_of_range<elem_t, std::array<xstr::separator<elem_t>, sizeof...(more) + 1>>
+	{
+		return xstr::split_of_range<elem_t, std::array<xstr::separator<elem_t>, sizeof...(more) + 1>>
+		{
+			view_t{ this->m_Buffer.data(), this->m_CharCount },
+			std::array<xstr::separator<elem_t>, sizeof...(more) + 1>
+			{
+				xstr::separator<elem_t>{ one },
+				xstr::separator<elem_t>{ more }...
+			}
+		};
+	}
 
 	template<class elem_t>
 	inline auto base_string_buffer<elem_t>::split_of(
@@ -576,123 +689,72 @@ namespace utils::xstr
 			return;
 		}
 
+		const view_t view{ this->m_Buffer.data(), this->m_CharCount };
+		size_t found{ xstr::search(view, o_string, offset) };
+		if (found == npos)
+		{
+			return;
+		}
+
 		const size_t o_length{ o_string.size() };
 		const size_t n_length{ n_string.size() };
-		std::vector<size_t> finds{};
-		{
-			view_t view{ this->m_Buffer.data(), this->m_CharCount };
+		size_t replaced{};
 
-			for (size_t current{ offset }, find{ 0 }; current < view.size();)
+		if (n_length <= o_length)
+		{
+			// 替换后不会变长：原地从前往后压缩，写入位置始终不超过读取位置，后面未处理的部分保持原样
+			elem_t* data{ this->m_Buffer.data() };
+			size_t read{ found }, write{ found };
+			do
 			{
-				size_t pos = view.find(o_string, current);
-				if (pos == npos)
-				{
-					break;
-				}
-
-				finds.push_back(pos);
-				if (++find == count)
+				if (write != read)
 				{
-					break;
+					std::copy(data + read, data + found, data + write);
 				}
-				current = pos + o_length;
-			}
-
-			if (finds.empty())
+				write += found - read;
+				std::copy(n_string.begin(), n_string.end(), data + write);
+				write += n_length;
+				read = found + o_length;
+				found = ++replaced == count ? npos : xstr::search(view, o_string, read);
+			} while (found != npos);
+
+			if (write != read)
 			{
-				return;
+				std::copy(data + read, data + this->m_CharCount, data + write);
 			}
+			this->m_CharCount = write + (this->m_CharCount - read);
 		}
-
-		if (n_length > o_length)
+		else
 		{
-			const size_t n_size{ (n_length - o_length) * finds.size() };
-			const size_t n_count{ this->m_CharCount + n_size };
-			if (n_count >= this->m_Buffer.size())
-			{
-				std::vector<elem_t> o_buffer{ std::move(this->m_Buffer) };
-				this->check(n_count);
-				this->reset();
+			// 替换后变长：边查找边写入另一块缓冲区，完成后交换；换下来的旧缓冲区留给下一次使用
+			static thread_local vector_t output{};
+			output.resize(std::max(output.capacity(), this->m_CharCount + n_length + 1));
 
-				size_t current{ 0 };
-				elem_t* data{ o_buffer.data() };
-				for (const size_t& pos : finds)
-				{
-					elem_t* first{ data + current };
-					elem_t* last{ data + pos };
-					size_t  count{ static_cast<size_t>(last - first) };
-
-					view_t substr{ first,  count };
-					if (!substr.empty())
-					{
-						this->write(substr);
-						current += substr.size();
-					}
-					this->write(n_string);
-					current += o_length;
-				}
-			}
-			else
+			size_t write{};
+			const auto append = [&write](const elem_t* first, const size_t length) -> void
 			{
-				size_t cur_pos{ n_count - 1 };
-				size_t end_pos{ this->m_CharCount };
-				elem_t* data{ this->m_Buffer.data() };
-				for (const size_t& pos : std::ranges::reverse_view(finds))
+				if (write + length + 1 > output.size())
 				{
-					elem_t* first{ data + pos + o_length };
-					elem_t* last { data + end_pos };
-					size_t  count{ static_cast<size_t>(last - first) };
-
-					view_t substr{ first,  count };
-					if (!substr.empty())
-					{
-						auto size{ substr.size() };
-						end_pos -= size;
-						cur_pos -= size;
-						elem_t* dest{ data + cur_pos + 1 };
-						std::copy(substr.begin(), substr.end(), dest);
-					}
-
-					end_pos -= o_length;
-					cur_pos -= n_length;
-					elem_t* dest{ data + cur_pos + 1 };
-					std::copy(n_string.begin(), n_string.end(), dest);
+					const size_t growth{ std::max(write + length + 1, output.size() + output.size() / 2) };
+					output.resize((growth + (min_growth - 1)) & ~(min_growth - 1));
 				}
-				this->m_CharCount = n_count;
-			}
-		}
-		else if (n_length == o_length)
-		{
-			elem_t* data{ this->m_Buffer.data() };
-			for (const size_t& pos : finds)
-			{
-				auto dest{ data + pos };
-				std::copy(n_string.begin(), n_string.end(), dest);
-			}
-		}
-		else
-		{
-			elem_t* data{ this->m_Buffer.data() };
-			size_t diffs{ o_length - n_length };
+				std::copy(first, first + length, output.data() + write);
+				write += length;
+			};
 
-			for (size_t i = 0, count{ 0 }, size{ finds.size() }; i < size; i++)
+			const elem_t* data{ this->m_Buffer.data() };
+			size_t read{};
+			do
 			{
-				size_t cur{ finds[i] };
-				auto find { reinterpret_cast<elem_t*>(data + cur - count) };
-				std::copy(n_string.begin(), n_string.end(), find);
-
-				auto str{ reinterpret_cast<elem_t*>(find + o_length + count) };
-				auto len
-				{
-					i + 1 != size ?
-					size_t{ finds[i + 1] - (cur + o_length) } :
-					size_t{ this->m_CharCount - ((cur - count) + o_length + count) }
-				};
-				auto substr = view_t{ str, len };
-				std::copy(substr.begin(), substr.end(), find + n_length);
-				count = { count + diffs };
-			}
-			this->m_CharCount -= diffs * finds.size();
+				append(data + read, found - read);
+				append(n_string.data(), n_length);
+				read = found + o_length;
+				found = ++replaced == count ? npos : xstr::search(view, o_string, read);
+			} while (found != npos);
+			append(data + read, this->m_CharCount - read);
+
+			std::swap(this->m_Buffer, output);
+			this->m_CharCount = write;
 		}
 		this->m_Buffer[this->m_CharCount] = empty[0];
 	}
@@ -703,7 +765,7 @@ namespace utils::xstr
 		size_t offset, size_t count) -> void
 	{
 		auto string{ xstr::convert_to_view<elem_t>(str_or_char) };
-		this->replace(string, view_t{ empty }, offset, count);
+		this->replace(string, view_t{}, offset, count); // 走原地压缩的路径
 	}
 
 	template<class elem_t>
@@ -748,7 +810,7 @@ namespace utils::xstr
 	template<class elem_t>
 	inline auto base_string_buffer<elem_t>::find(view_t str, size_t ofs) -> size_t
 	{
-		size_t result = this->view().find(str, ofs);
+		size_t result = xstr::search(this->view(), str, ofs);
 		return result;
 	}
 
@@ -953,6 +1015,14 @@ namespace utils::xstr
 			return this->write_as_format(str, std::forward<T&&>(args)...);
 		}
 
+		template<class ...T>
+		requires (sizeof(elem_t) == sizeof(char) || sizeof(elem_t) == sizeof(wchar_t))
+		inline auto format(const typename base_string_buffer<elem_t>::template format_string_t<T...> fmt, T&& ...args) -> derived_t&
+		{
+			base_string_buffer<elem_t>::format(fmt, std::forward<T>(args)...);
+			return this->self();
+		}
+
 		template <class iterator_t>
 		inline auto write(iterator_t begin, iterator_t end) -> derived_t&
 		{
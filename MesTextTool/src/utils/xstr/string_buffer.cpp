@@ -10,6 +10,7 @@ namespace utils::xstr
 		// string_converter.cpp
 		inline constexpr int string_type{ 1 };
 		inline constexpr int vector_type{ 2 };
+		inline constexpr int storage_type{ 3 };
 		extern auto convert_to_utf16(std::string_view buffer, void* out, int out_type, uint32_t cdpg) -> bool;
 		extern auto convert_to_string(std::wstring_view buffer, void* out, int out_type, uint32_t cdpg) -> bool;
 		extern auto convert_encoding(void* buffer, void* out, uint32_t o_cdpg, uint32_t n_cdpg) -> bool;
@@ -187,7 +188,7 @@ namespace utils::xstr
 		{
 			const auto data{ reinterpret_cast<char*>(this->m_Buffer.data()) };
 			std::string_view buffer{ data, this->m_CharCount };
-			unsafe::convert_to_utf16(buffer, &result.m_Buffer, unsafe::vector_type, CP_UTF8);
+			unsafe::convert_to_utf16(buffer, &result.m_Buffer, unsafe::storage_type, CP_UTF8);
 			result.recount();
 		}
 		return result;
@@ -204,7 +205,7 @@ namespace utils::xstr
 		{
 			const auto data{ reinterpret_cast<char*>(this->m_Buffer.data()) };
 			std::string_view buffer{ data, this->m_CharCount };
-			unsafe::convert_to_utf16(buffer, &result.m_Buffer, unsafe::vector_type, CP_UTF8);
+			unsafe::convert_to_utf16(buffer, &result.m_Buffer, unsafe::storage_type, CP_UTF8);
 			result.recount();
 		}
 		return result;
@@ -214,7 +215,7 @@ namespace utils::xstr
 	{
 		xstr::wstring_buffer result{};
 		{
-			unsafe::convert_to_utf16(this->view(), &result.m_Buffer, unsafe::vector_type, cdpg);
+			unsafe::convert_to_utf16(this->view(), &result.m_Buffer, unsafe::storage_type, cdpg);
 			result.recount();
 		}
 		return result;
@@ -224,7 +225,7 @@ namespace utils::xstr
 	{
 		xstr::u16string_buffer result{};
 		{
-			unsafe::convert_to_utf16(this->view(), &result.m_Buffer, unsafe::vector_type, cdpg);
+			unsafe::convert_to_utf16(this->view(), &result.m_Buffer, unsafe::storage_type, cdpg);
 			result.recount();
 		}
 		return result;
@@ -241,7 +242,7 @@ namespace utils::xstr
 	{
 		xstr::string_buffer result{};
 		{
-			unsafe::convert_to_string(this->view(), &result.m_Buffer, unsafe::vector_type, to_codepage);
+			unsafe::convert_to_string(this->view(), &result.m_Buffer, unsafe::storage_type, to_codepage);
 			result.recount();
 		}
 		return result;
@@ -251,7 +252,7 @@ namespace utils::xstr
 	{
 		xstr::u8string_buffer result{};
 		{
-			unsafe::convert_to_string(this->view(), &result.m_Buffer, unsafe::vector_type, CP_UTF8);
+			unsafe::convert_to_string(this->view(), &result.m_Buffer, unsafe::storage_type, CP_UTF8);
 			result.recount();
 		}
 		return result;
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <windows.h>
+#include "base_string_buffer.hpp"
 #include "string_converter.hpp"
 
 namespace utils::xstr
@@ -8,12 +9,25 @@ namespace utils::xstr
 
 	namespace unsafe
 	{
-		inline constexpr int string_type{ 1 };
-		inline constexpr int vector_type{ 2 };
+		inline constexpr int string_type { 1 };
+		inline constexpr int vector_type { 2 };
+		inline constexpr int storage_type{ 3 }; // base_string_buffer 的 string_vector
+
+		// 为 vector 类输出预留 count 个字符与结尾的 '\0'，容量不足时先清空以避免复制旧内容
+		template<class vector_t>
+		static inline auto prepare(vector_t* vector, const size_t count) -> typename vector_t::value_type*
+		{
+			if (vector->capacity() < count + 1)
+			{
+				vector->clear();
+			}
+			vector->resize(count + 1);
+			return vector->data();
+		}
 
 		auto convert_to_utf16(std::string_view buffer, void* out, int out_type, uint32_t cdpg) -> bool
 		{
-			union { void* raw; std::wstring* wstring; std::vector<wchar_t>* vector; }_outbuf{ out };
+			union { void* raw; std::wstring* wstring; std::vector<wchar_t>* vector; string_vector<wchar_t>* storage; }_outbuf{ out };
 
 			if (buffer.empty() || out == nullptr)
 			{
@@ -23,6 +37,7 @@ namespace utils::xstr
 			const auto _count{ ::MultiByteToWideChar(cdpg, 0, buffer.data(), buffer.size(), nullptr, 0) };
 			if (_count > 0)
 			{
+				wchar_t* outbuf{};
 				if (out_type == unsafe::string_type)
 				{
 					if (_outbuf.wstring->capacity() < _count + 1)
@@ -30,20 +45,20 @@ namespace utils::xstr
 						_outbuf.wstring->clear();
 					}
 					_outbuf.wstring->resize(_count);
+					outbuf = _outbuf.wstring->data();
 				}
 				else if (out_type == unsafe::vector_type)
 				{
-					if (_outbuf.vector->capacity() < _count + 1)
-					{
-						_outbuf.vector->clear();
-					}
-					_outbuf.vector->resize(_count + 1);
+					outbuf = unsafe::prepare(_outbuf.vector, _count);
+				}
+				else if (out_type == unsafe::storage_type)
+				{
+					outbuf = unsafe::prepare(_outbuf.storage, _count);
 				}
 				else
 				{
 					return false;
 				}
-				wchar_t* const outbuf{ out_type == 1 ? _outbuf.wstring->data() : _outbuf.vector->data() };
 				::MultiByteToWideChar(cdpg, 0, buffer.data(), buffer.size(), outbuf, _count);
 				outbuf[static_cast<size_t>(_count)] = L'\0';
 			}
@@ -53,7 +68,7 @@ namespace utils::xstr
 
 		auto convert_to_string(std::wstring_view buffer, void* out, int out_type, uint32_t cdpg) -> bool
 		{
-			union { void* raw; std::string* string; std::vector<char>* vector; }_outbuf{ out };
+			union { void* raw; std::string* string; std::vector<char>* vector; string_vector<char>* storage; }_outbuf{ out };
 			if (buffer.empty() || out == nullptr)
 			{
 				return false;
@@ -62,6 +77,7 @@ namespace utils::xstr
 			const auto _count{ ::WideCharToMultiByte(cdpg, 0, buffer.data(), buffer.size(), nullptr, 0, NULL, NULL) };
 			if (_count > 0)
 			{
+				char* outbuf{};
 				if (out_type == unsafe::string_type)
 				{
 					if (_outbuf.string->capacity() < _count + 1)
@@ -69,27 +85,27 @@ namespace utils::xstr
 						_outbuf.string->clear();
 					}
 					_outbuf.string->resize(_count);
+					outbuf = _outbuf.string->data();
 				}
 				else if (out_type == unsafe::vector_type)
 				{
-					if (_outbuf.vector->capacity() < _count + 1) 
-					{
-						_outbuf.vector->clear();
-					}
-					_outbuf.vector->resize(_count + 1);
+					outbuf = unsafe::prepare(_outbuf.vector, _count);
+				}
+				else if (out_type == unsafe::storage_type)
+				{
+					outbuf = unsafe::prepare(_outbuf.storage, _count);
 				}
 				else
 				{
 					return false;
 				}
-				char* const outbuf{ out_type == 1 ? _outbuf.string->data() : _outbuf.vector->data() };
 				::WideCharToMultiByte(cdpg, 0, buffer.data(), buffer.size(), outbuf, _count, NULL, NULL);
 				outbuf[static_cast<size_t>(_count)] = '\0';
 			}
 			return true;
 		}
 
-		// [buffer: char* or std::vector<char>*] [out: std::string or std::vector<char>]
+		// [buffer: char*, std::vector<char>* or string_vector<char>*] [out: std::string, std::vector<char> or string_vector<char>]
 		auto convert_encoding(void* buffer, int buffer_type, void* out, int out_type, uint32_t o_cdpg, uint32_t n_cdpg) -> bool 
 		{
 			if (o_cdpg == n_cdpg || buffer == nullptr || out == nullptr)
@@ -108,6 +124,10 @@ namespace utils::xstr
 				{
 					_buffer = reinterpret_cast<std::vector<char>*>(buffer)->data();
 				}
+				else if (buffer_type == unsafe::storage_type)
+				{
+					_buffer = reinterpret_cast<string_vector<char>*>(buffer)->data();
+				}
 
 				if (_buffer == nullptr)
 				{
@@ -130,12 +150,12 @@ namespace utils::xstr
 			return result;
 		}
 
-		// [buffer -> std::vector<char>*] [out -> std::vector<char>*]
+		// [buffer -> string_vector<char>*] [out -> string_vector<char>*]
 		auto convert_encoding(void* buffer, void* out, uint32_t o_cdpg, uint32_t n_cdpg) -> bool
 		{
-			auto _buffer{ reinterpret_cast<std::vector<char>*>(buffer) };
-			auto _outbuf{ reinterpret_cast<std::vector<char>*>(out != nullptr && buffer != out ? out : buffer) };
-			return convert_encoding(_buffer, unsafe::vector_type, _outbuf, unsafe::vector_type, o_cdpg, n_cdpg);
+			auto _buffer{ reinterpret_cast<string_vector<char>*>(buffer) };
+			auto _outbuf{ reinterpret_cast<string_vector<char>*>(out != nullptr && buffer != out ? out : buffer) };
+			return convert_encoding(_buffer, unsafe::storage_type, _outbuf, unsafe::storage_type, o_cdpg, n_cdpg);
 		}
 	}
 
@@ -185,6 +205,11 @@ namespace utils::xstr
 		unsafe::convert_to_utf16(input, &output, unsafe::vector_type, current_code_page);
 	}
 
+	auto convert_to_utf16(std::string_view input, string_vector<wchar_t>& output, uint32_t current_code_page) -> void 
+	{
+		unsafe::convert_to_utf16(input, &output, unsafe::storage_type, current_code_page);
+	}
+
 	auto convert_to_utf16(std::string_view input, uint32_t current_code_page) -> std::wstring
 	{
 		std::wstring result{};
@@ -12,6 +12,7 @@ namespace utils::xstr
 	auto encoding_convert(std::wstring_view input, uint32_t target_code_page) -> std::string;
 
 	auto convert_to_utf16(std::string_view input, std::vector<wchar_t>& output, uint32_t current_code_page) -> void;
+	auto convert_to_utf16(std::string_view input, string_vector<wchar_t>& output, uint32_t current_code_page) -> void;
 	auto convert_to_utf16(std::string_view intput, std::wstring& output, uint32_t current_code_page = 0) -> void;
 	auto convert_to_utf16(std::string_view intput, uint32_t current_code_page = 0) -> std::wstring;
 
@@ -83,6 +84,11 @@ namespace utils::xstr
 			xstr::convert_to_utf16(intput, output, current_code_page);
 		}
 
+		inline auto to_utf16(std::string_view intput, string_vector<wchar_t>& output, uint32_t current_code_page = 0) -> void
+		{
+			xstr::convert_to_utf16(intput, output, current_code_page);
+		}
+
 		template<class R = std::wstring>
 		requires wstring_t<R>
 		inline auto to_utf16(std::string_view intput, uint32_t current_code_page = 0) -> R
@@ -11,24 +11,6 @@ namespace utils::xstr
 		inline static constexpr const elem_t LF{ static_cast<elem_t>('\n') };
 		inline static constexpr const elem_t CR{ static_cast<elem_t>('\r') };
 
-		inline static constexpr const elem_t CRLF[3]
-		{
-			static_cast<elem_t>('\r'),
-			static_cast<elem_t>('\n'),
-			static_cast<elem_t>('\0')
-		};
-
-		inline static constexpr const elem_t WHITESPACE[7]
-		{
-			static_cast<elem_t>(' ' ),
-			static_cast<elem_t>('\n'),
-			static_cast<elem_t>('\t'),
-			static_cast<elem_t>('\v'),
-			static_cast<elem_t>('\f'),
-			static_cast<elem_t>('\r'),
-			static_cast<elem_t>('\0')
-		};
-
 	public:
 
 		using string_view_t = std::basic_string_view<elem_t, std::char_traits<elem_t>>;
@@ -131,17 +113,7 @@ namespace utils::xstr
 		auto line{ this->m_parser->m_string_view.substr(this->m_index, this->m_count) };
 		if (this->m_parser->m_trim_need)
 		{
-			const auto beg{ line.find_first_not_of(string_lines_parser<elem_t>::WHITESPACE) };
-			if (beg != std::u8string_view::npos)
-			{
-				line = line.substr(beg);
-				const auto end{ line.find_last_not_of(string_lines_parser<elem_t>::WHITESPACE) };
-				line = line.substr(0, end + 1);
-			}
-			else 
-			{
-				line = {};
-			}
+			line = xstr::trim_space(line);
 		}
 		return line;
 	}
@@ -193,7 +165,7 @@ namespace utils::xstr
 			return this->end();
 		}
 
-		auto next_index{ this->m_string_view.find_first_of(string_lines_parser<elem_t>::CRLF, this->m_current_index) };
+		auto next_index{ xstr::find_line_break(this->m_string_view, this->m_current_index) };
 
 		if (next_index == string_lines_parser<elem_t>::string_view_t::npos)
 		{
@@ -0,0 +1,218 @@
+#pragma once
+#define _string_search_
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define _xstr_search_sse2_
+#endif
+
+namespace utils::xstr
+{
+
+	// 子串查找：先用 SIMD 同时比较候选位置的首、尾字符，两者都相同的位置才逐个比较中间部分
+	// 只对 1、2 字节的字符做向量化，其它情况与剩余不足一个块的部分交给 basic_string_view::find
+	template<class elem_t>
+	inline auto search(const std::basic_string_view<elem_t> str, const std::basic_string_view<elem_t> target, size_t offset = 0) noexcept -> size_t
+	{
+		const size_t length{ target.size() };
+		if (length == 0 || offset >= str.size() || str.size() - offset < length)
+		{
+			return str.find(target, offset);
+		}
+
+#ifdef _xstr_search_sse2_
+		if constexpr (sizeof(elem_t) == 1 || sizeof(elem_t) == 2)
+		{
+			constexpr size_t lanes{ sizeof(__m128i) / sizeof(elem_t) };
+
+			const elem_t* const data{ str.data() };
+			const size_t last{ str.size() - length }; // 最后一个可能的起点
+
+			__m128i first_v, last_v;
+			if constexpr (sizeof(elem_t) == 1)
+			{
+				first_v = _mm_set1_epi8(static_cast<char>(target.front()));
+				last_v  = _mm_set1_epi8(static_cast<char>(target.back ()));
+			}
+			else
+			{
+				first_v = _mm_set1_epi16(static_cast<short>(target.front()));
+				last_v  = _mm_set1_epi16(static_cast<short>(target.back ()));
+			}
+
+			size_t current{ offset };
+			for (; current + lanes <= last + 1; current += lanes)
+			{
+				const __m128i block_f{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + current)) };
+				const __m128i block_l{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + current + length - 1)) };
+
+				uint32_t mask{};
+				if constexpr (sizeof(elem_t) == 1)
+				{
+					mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_f, first_v), _mm_cmpeq_epi8(block_l, last_v))));
+				}
+				else
+				{
+					// 每个 16 位元素在掩码中占两位，只保留低位
+					mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(block_f, first_v), _mm_cmpeq_epi16(block_l, last_v)))) & 0x5555u;
+				}
+
+				while (mask != 0)
+				{
+					const size_t position{ current + static_cast<size_t>(std::countr_zero(mask)) / sizeof(elem_t) };
+					if (length <= 2 || std::char_traits<elem_t>::compare(data + position + 1, target.data() + 1, length - 2) == 0)
+					{
+						return position;
+					}
+					mask &= mask - 1;
+				}
+			}
+
+			return str.find(target, current);
+		}
+#endif
+		return str.find(target, offset);
+	}
+
+#ifdef _xstr_search_sse2_
+	namespace simd
+	{
+		// 按元素大小选择 8 / 16 位指令，掩码中每个元素只保留最低的一位
+		template<class elem_t>
+		inline auto set1(const elem_t value) noexcept -> __m128i
+		{
+			if constexpr (sizeof(elem_t) == 1) { return _mm_set1_epi8(static_cast<char>(value)); }
+			else { return _mm_set1_epi16(static_cast<short>(value)); }
+		}
+
+		template<class elem_t>
+		inline auto cmpeq(const __m128i a, const __m128i b) noexcept -> __m128i
+		{
+			if constexpr (sizeof(elem_t) == 1) { return _mm_cmpeq_epi8(a, b); }
+			else { return _mm_cmpeq_epi16(a, b); }
+		}
+
+		template<class elem_t>
+		inline auto mask(const __m128i value) noexcept -> uint32_t
+		{
+			const uint32_t result{ static_cast<uint32_t>(_mm_movemask_epi8(value)) };
+			if constexpr (sizeof(elem_t) == 1) { return result; }
+			else { return result & 0x5555u; }
+		}
+
+		// 空白字符：' ' 与 '\t' ~ '\r'，后者用 (c - '\t') 饱和减 4 为零判断
+		template<class elem_t>
+		inline auto is_space(const __m128i block) noexcept -> __m128i
+		{
+			const __m128i zero{ _mm_setzero_si128() };
+			if constexpr (sizeof(elem_t) == 1)
+			{
+				const __m128i range{ _mm_subs_epu8(_mm_sub_epi8(block, _mm_set1_epi8('\t')), _mm_set1_epi8(4)) };
+				return _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(range, zero));
+			}
+			else
+			{
+				const __m128i range{ _mm_subs_epu16(_mm_sub_epi16(block, _mm_set1_epi16('\t')), _mm_set1_epi16(4)) };
+				return _mm_or_si128(_mm_cmpeq_epi16(block, _mm_set1_epi16(' ')), _mm_cmpeq_epi16(range, zero));
+			}
+		}
+
+		template<class elem_t>
+		inline auto load(const elem_t* data) noexcept -> __m128i
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		}
+	}
+#endif
+
+	template<class elem_t>
+	inline constexpr auto is_whitespace(const elem_t chr) noexcept -> bool
+	{
+		return chr == static_cast<elem_t>(' ') || (chr >= static_cast<elem_t>('\t') && chr <= static_cast<elem_t>('\r'));
+	}
+
+	// 查找第一个 '\r' 或 '\n'，每次处理 32 字节（两个 SSE2 块）
+	template<class elem_t>
+	inline auto find_line_break(const std::basic_string_view<elem_t> str, size_t offset = 0) noexcept -> size_t
+	{
+		const elem_t* const data{ str.data() };
+		const size_t size{ str.size() };
+
+#ifdef _xstr_search_sse2_
+		if constexpr (sizeof(elem_t) == 1 || sizeof(elem_t) == 2)
+		{
+			constexpr size_t lanes{ sizeof(__m128i) / sizeof(elem_t) };
+			const __m128i cr{ simd::set1<elem_t>(static_cast<elem_t>('\r')) };
+			const __m128i lf{ simd::set1<elem_t>(static_cast<elem_t>('\n')) };
+
+			const auto breaks = [&cr, &lf](const __m128i block) -> __m128i
+			{
+				return _mm_or_si128(simd::cmpeq<elem_t>(block, cr), simd::cmpeq<elem_t>(block, lf));
+			};
+
+			for (; offset + lanes * 2 <= size; offset += lanes * 2)
+			{
+				const __m128i first { breaks(simd::load(data + offset)) };
+				const __m128i second{ breaks(simd::load(data + offset + lanes)) };
+				if (_mm_movemask_epi8(_mm_or_si128(first, second)) == 0)
+				{
+					continue;
+				}
+
+				const uint32_t mask{ simd::mask<elem_t>(first) | (simd::mask<elem_t>(second) << 16) };
+				return offset + static_cast<size_t>(std::countr_zero(mask)) / sizeof(elem_t);
+			}
+		}
+#endif
+		for (; offset < size; ++offset)
+		{
+			if (data[offset] == static_cast<elem_t>('\r') || data[offset] == static_cast<elem_t>('\n'))
+			{
+				return offset;
+			}
+		}
+		return std::basic_string_view<elem_t>::npos;
+	}
+
+	// 去掉首尾空白，按块分类，行首、行尾各自只需要找到第一个非空白字符所在的块
+	template<class elem_t>
+	inline auto trim_space(const std::basic_string_view<elem_t> str) noexcept -> std::basic_string_view<elem_t>
+	{
+		const elem_t* const data{ str.data() };
+		size_t beg{}, end{ str.size() };
+
+#ifdef _xstr_search_sse2_
+		if constexpr (sizeof(elem_t) == 1 || sizeof(elem_t) == 2)
+		{
+			constexpr size_t lanes{ sizeof(__m128i) / sizeof(elem_t) };
+			constexpr uint32_t all{ sizeof(elem_t) == 1 ? 0xFFFFu : 0x5555u };
+
+			for (; beg + lanes <= end; beg += lanes)
+			{
+				const uint32_t mask{ ~simd::mask<elem_t>(simd::is_space<elem_t>(simd::load(data + beg))) & all };
+				if (mask != 0)
+				{
+					beg += static_cast<size_t>(std::countr_zero(mask)) / sizeof(elem_t);
+					break;
+				}
+			}
+
+			for (; end >= beg + lanes; end -= lanes)
+			{
+				const uint32_t mask{ ~simd::mask<elem_t>(simd::is_space<elem_t>(simd::load(data + end - lanes))) & all };
+				if (mask != 0)
+				{
+					end = end - lanes + static_cast<size_t>(std::bit_width(mask) - 1) / sizeof(elem_t) + 1;
+					break;
+				}
+			}
+		}
+#endif
+		while (beg < end && xstr::is_whitespace(data[beg])) { ++beg; }
+		while (end > beg && xstr::is_whitespace(data[end - 1])) { --end; }
+		return std::basic_string_view<elem_t>{ data + beg, end - beg };
+	}
+}
@@ -0,0 +1,239 @@
+#pragma once
+#define _string_split_
+#include <array>
+#include <span>
+#include <ranges>
+#include <iterator>
+#include <string_view>
+#include "string_search.hpp"
+
+namespace utils::xstr
+{
+
+	// 惰性切分用的分隔符：单个字符保存在自身中，而不是像 convert_to_view 那样指向调用者的参数，复制后仍然有效
+	template<class elem_t>
+	class separator
+	{
+	public:
+		using view_t = std::basic_string_view<elem_t>;
+
+		inline separator() noexcept = default;
+		inline separator(const view_t string) noexcept : m_string{ string } {}
+
+		template<class T>
+		requires (sizeof(T) == sizeof(elem_t) && std::convertible_to<T, elem_t>)
+		inline separator(const T elem) noexcept : m_elem{ static_cast<elem_t>(elem) }, m_single{ true } {}
+
+		template<class T>
+		requires (!(sizeof(T) == sizeof(elem_t) && std::convertible_to<T, elem_t>) && std::convertible_to<const T&, view_t>)
+		inline separator(const T& string) noexcept : m_string{ view_t{ string } } {}
+
+		inline auto view() const noexcept -> view_t
+		{
+			return this->m_single ? view_t{ &this->m_elem, 1 } : this->m_string;
+		}
+
+	protected:
+		view_t m_string{};
+		elem_t m_elem{};
+		bool m_single{};
+	};
+
+	// 按单个分隔符惰性切分，遍历时才查找下一段，不分配内存；count 为最多产生的段数
+	// 分隔符为空或字符串为空时只产生原字符串本身，末尾紧跟分隔符时不产生空段
+	template<class elem_t>
+	class split_range : public std::ranges::view_interface<split_range<elem_t>>
+	{
+	public:
+		using view_t = std::basic_string_view<elem_t>;
+
+		class iterator
+		{
+		public:
+			using value_type        = view_t;
+			using difference_type   = std::ptrdiff_t;
+			using iterator_concept  = std::forward_iterator_tag;
+
+			inline iterator() noexcept = default;
+
+			inline iterator(const view_t string, const xstr::separator<elem_t>& separator, const size_t count) noexcept
+				: m_string{ string }, m_separator{ separator }, m_count{ count }
+			{
+				if (separator.view().empty() || string.empty())
+				{
+					this->m_piece = string;
+					this->m_last  = true;
+				}
+				else
+				{
+					this->next();
+				}
+			}
+
+			inline auto operator*() const noexcept -> value_type { return this->m_piece; }
+			inline auto operator++() noexcept -> iterator& { this->next(); return *this; }
+			inline auto operator++(int) noexcept -> iterator { iterator temp{ *this }; this->next(); return temp; }
+			inline auto operator==(const iterator& other) const noexcept -> bool
+			{
+				return this->m_done == other.m_done && (this->m_done || this->m_piece.data() == other.m_piece.data());
+			}
+			inline auto operator==(std::default_sentinel_t) const noexcept -> bool { return this->m_done; }
+
+		protected:
+
+			inline auto next() noexcept -> void
+			{
+				const view_t& string{ this->m_string };
+				if (this->m_last || this->m_current >= string.size())
+				{
+					this->m_done = true;
+					return;
+				}
+
+				const view_t separator{ this->m_separator.view() };
+				const size_t pos{ xstr::search(string, separator, this->m_current) };
+				if (pos == view_t::npos)
+				{
+					this->m_piece = string.substr(this->m_current);
+					this->m_last  = true;
+					return;
+				}
+
+				this->m_piece   = string.substr(this->m_current, pos - this->m_current);
+				this->m_current = pos + separator.size();
+				this->m_last    = ++this->m_found == this->m_count;
+			}
+
+			// 迭代器自带切分所需的全部状态，不引用 range 本身，range 被移动后迭代器仍然有效
+			view_t m_string{};
+			xstr::separator<elem_t> m_separator{};
+			size_t m_count{};
+			view_t m_piece{};
+			size_t m_current{};
+			size_t m_found{};
+			bool m_last{};
+			bool m_done{};
+		};
+
+		inline split_range() noexcept = default;
+		inline split_range(const view_t string, const xstr::separator<elem_t> separator, const size_t count = static_cast<size_t>(-1)) noexcept
+			: m_string{ string }, m_separator{ separator }, m_count{ count }
+		{
+		}
+
+		inline auto begin() const noexcept -> iterator { return iterator{ this->m_string, this->m_separator, this->m_count }; }
+		inline auto end  () const noexcept -> std::default_sentinel_t { return std::default_sentinel; }
+
+	protected:
+		view_t m_string{};
+		xstr::separator<elem_t> m_separator{};
+		size_t m_count{};
+	};
+
+	// 按多个分隔符中任意一个惰性切分，同一位置按给出的顺序匹配；count 为最多切分的次数，达到后剩余部分作为最后一段
+	// separators_t 为 std::array<separator> 时自带分隔符，为 std::span 时引用调用者的分隔符，两者都不分配内存
+	template<class elem_t, class separators_t>
+	class split_of_range : public std::ranges::view_interface<split_of_range<elem_t, separators_t>>
+	{
+	public:
+		using view_t = std::basic_string_view<elem_t>;
+
+		class iterator
+		{
+		public:
+			using value_type        = view_t;
+			using difference_type   = std::ptrdiff_t;
+			using iterator_concept  = std::forward_iterator_tag;
+
+			inline iterator() noexcept = default;
+
+			inline iterator(const view_t string, const separators_t& separators, const size_t count) noexcept
+				: m_string{ string }, m_separators{ separators }, m_count{ count }
+			{
+				this->next();
+			}
+
+			inline auto operator*() const noexcept -> value_type { return this->m_piece; }
+			inline auto operator++() noexcept -> iterator& { this->next(); return *this; }
+			inline auto operator++(int) noexcept -> iterator { iterator temp{ *this }; this->next(); return temp; }
+			inline auto operator==(const iterator& other) const noexcept -> bool
+			{
+				return this->m_done == other.m_done && (this->m_done || this->m_piece.data() == other.m_piece.data());
+			}
+			inline auto operator==(std::default_sentinel_t) const noexcept -> bool { return this->m_done; }
+
+		protected:
+
+			static inline auto view_of(const view_t& separator) noexcept -> view_t { return separator; }
+			static inline auto view_of(const xstr::separator<elem_t>& separator) noexcept -> view_t { return separator.view(); }
+
+			inline auto next() noexcept -> void
+			{
+				const view_t& string{ this->m_string };
+				if (this->m_last)
+				{
+					this->m_done = true;
+					return;
+				}
+
+				// 切分次数用完后剩余部分（可能为空）作为最后一段
+				if (this->m_found == this->m_count)
+				{
+					this->m_piece = string.substr(this->m_current);
+					this->m_last  = true;
+					return;
+				}
+
+				// 第一段总是产生（空串也产生一个空段），之后到达末尾就结束
+				if (this->m_started && this->m_current >= string.size())
+				{
+					this->m_done = true;
+					return;
+				}
+				this->m_started = true;
+
+				for (size_t pos{ this->m_current }; pos < string.size(); ++pos)
+				{
+					for (const auto& item : this->m_separators)
+					{
+						const view_t separator{ iterator::view_of(item) };
+						if (!separator.empty() && string.substr(pos, separator.size()) == separator)
+						{
+							this->m_piece   = string.substr(this->m_current, pos - this->m_current);
+							this->m_current = pos + separator.size();
+							this->m_found++;
+							return;
+						}
+					}
+				}
+
+				this->m_piece = string.substr(this->m_current);
+				this->m_last  = true;
+			}
+
+			view_t m_string{};
+			separators_t m_separators{};
+			size_t m_count{};
+			view_t m_piece{};
+			size_t m_current{};
+			size_t m_found{};
+			bool m_started{};
+			bool m_last{};
+			bool m_done{};
+		};
+
+		inline split_of_range() noexcept = default;
+		inline split_of_range(const view_t string, const separators_t separators, const size_t count = static_cast<size_t>(-1)) noexcept
+			: m_string{ string }, m_separators{ separators }, m_count{ count }
+		{
+		}
+
+		inline auto begin() const noexcept -> iterator { return iterator{ this->m_string, this->m_separators, this->m_count }; }
+		inline auto end  () const noexcept -> std::default_sentinel_t { return std::default_sentinel; }
+
+	protected:
+		view_t m_string{};
+		separators_t m_separators{};
+		size_t m_count{};
+	};
+}
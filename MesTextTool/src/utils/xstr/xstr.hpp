@@ -58,6 +58,18 @@ namespace xstr
 			xstr::union_convertible_of<char_type, view_t> auto ...more
 		) const noexcept -> std::vector<view<char_type>>;
 
+		// 惰性切分，结果为 std::basic_string_view，不分配内存；规则与 split / split_of 相同
+		auto lazy_split(xstr::union_convertible_of<char_type, view_t> auto elem,
+			size_t count = unused) const noexcept -> xstr::split_range<char_type>;
+
+		auto lazy_split_of(std::span<const view_t> strings,
+			size_t count = unused) const noexcept -> xstr::split_of_range<char_type, std::span<const view_t>>;
+
+		auto lazy_split_of(
+			xstr::union_convertible_of<char_type, view_t> auto one,
+			xstr::union_convertible_of<char_type, view_t> auto ...more
+		) const noexcept -> xstr::split_of_range<char_type, std::array<xstr::separator<char_type>, sizeof...(more) + 1>>;
+
 		inline auto trim() noexcept -> view<char_type>&;
 	};
 
@@ -66,37 +78,10 @@ namespace xstr
 		size_t count) const noexcept -> std::vector<view<char_type>>
 	{
 		std::vector<view<char_type>> result{};
-		const view_t string{ xstr::convert_to_view<char_type>(elem)};
-		
-		if (!string.empty() && !this->empty()) 
+		for (const auto piece : this->lazy_split(elem, count))
 		{
-			for (size_t current{ 0 }, found{ 0 }; current < this->size();)
-			{
-				const size_t pos{ this->find(string, current) };
-				if (pos == std::basic_string_view<char_type>::npos)
-				{
-					auto length{ static_cast<size_t>(this->size() - current) };
-					auto substr{ this->substr(current, length) };
-					result.push_back(substr);
-					break;
-				}
-
-				auto length{ static_cast<size_t>(pos - current) };
-				auto substr{ this->substr(current, length) };
-				result.push_back(substr);
-
-				if (++found == count)
-				{
-					break;
-				}
-				current = pos + string.size();
-			}
-		}
-		else
-		{
-			result.push_back(*this);
+			result.push_back(piece);
 		}
-
 		return result;
 	}
 
@@ -105,44 +90,42 @@ namespace xstr
 		size_t count) const noexcept -> std::vector<view<char_type>>
 	{
 		std::vector<view<char_type>> result{};
+		for (const auto piece : this->lazy_split_of(std::span<const view_t>{ strings.begin(), strings.size() }, count))
+		{
+			result.push_back(piece);
+		}
+		return result;
+	}
+
+	template<class char_type>
+	inline auto view<char_type>::lazy_split(xstr::union_convertible_of<char_type, view_t> auto elem,
+		size_t count) const noexcept -> xstr::split_range<char_type>
+	{
+		return xstr::split_range<char_type>{ *this, xstr::separator<char_type>{ elem }, count };
+	}
+
+	template<class char_type>
+	inline auto view<char_type>::lazy_split_of(std::span<const view_t> strings,
+		size_t count) const noexcept -> xstr::split_of_range<char_type, std::span<const view_t>>
+	{
+		return xstr::split_of_range<char_type, std::span<const view_t>>{ *this, strings, count };
+	}
 
-		if (strings.size() > 0) 
+	template<class char_type>
+	inline auto view<char_type>::lazy_split_of(
+		xstr::union_convertible_of<char_type, view_t> auto one,
+		xstr::union_convertible_of<char_type, view_t> auto ...more
+	) const noexcept -> xstr::split_of_range<char_type, std::array<xstr::separator<char_type>, sizeof...(more) + 1>>
+	{
+		return xstr::split_of_range<char_type, std::array<xstr::separator<char_type>, sizeof...(more) + 1>>
 		{
-			for (size_t beg{ 0 }, end{ 0 }, find{ 0 }; end <= this->size(); ++end) 
+			*this,
+			std::array<xstr::separator<char_type>, sizeof...(more) + 1>
 			{
-				bool is_sep{ false };
-				for (const view_t& sep : strings)
-				{
-					auto split{ this->substr(end, sep.size()) };
-					if (split == sep) 
-					{
-						is_sep = true;
-						auto substr{ this->substr(beg, end - beg) };
-						result.push_back(substr);
-						end = end + sep.size();
-						beg = end;
-						find++;
-						break;
-					}
-				}
-				if (!is_sep && end == this->size())
-				{
-					auto substr{ this->substr(beg, end - beg) };
-					result.push_back(substr);
-				}
-				else if (find == count)
-				{
-					auto substr{ this->substr(end, this->size() - end) };
-					result.push_back(substr);
-					break;
-				}
+				xstr::separator<char_type>{ one },
+				xstr::separator<char_type>{ more }...
 			}
-		}
-		else
-		{
-			result.push_back(*this);
-		}
-		return result;
+		};
 	}
 
 	template<class char_type>